@@ -0,0 +1,88 @@
+#ifndef ELASTICIZE_BENCH_BENCHMARK_H_
+#define ELASTICIZE_BENCH_BENCHMARK_H_
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+#include <utility>
+
+#include <elasticize/gpu/engine.h>
+
+namespace elastic
+{
+namespace bench
+{
+// Named parameter values of one case in a sweep, e.g. { {"n", "1048576"}, {"distribution", "uniform"} }
+using Parameters = std::vector<std::pair<std::string, std::string>>;
+
+// Work done by one repetition, converted to rates from the median time
+struct Throughput
+{
+  double items = 0.;
+  std::string itemUnit = "items"; // reported as <itemUnit>/s
+  double bytes = 0.;              // reported as GB/s
+};
+
+struct Result
+{
+  std::string name;
+  Parameters parameters;
+  std::vector<double> samples; // seconds, one per repetition
+
+  double min = 0.;
+  double median = 0.;
+  double p95 = 0.;
+  double mean = 0.;
+
+  Throughput throughput;
+  double itemsPerSecond = 0.;
+  double gigabytesPerSecond = 0.;
+};
+
+class Benchmark
+{
+public:
+  struct Options
+  {
+    uint32_t warmup = 2;
+    uint32_t repetitions = 10;
+
+    // Written by save() when not empty
+    std::string jsonFilepath;
+    std::string csvFilepath;
+  };
+
+  // Parses --warmup=N, --repetitions=N, --json=PATH and --csv=PATH, ignoring other arguments
+  static Options parseArguments(int argc, char** argv);
+  static Options parseArguments(int argc, char** argv, Options options);
+
+  // Engine options for measuring; the validation layer is always off
+  static gpu::Engine::Options engineOptions(gpu::Engine::Options options = {});
+
+  // Powers of two from 2^firstExponent to 2^lastExponent inclusive
+  static std::vector<uint64_t> powersOfTwo(uint32_t firstExponent, uint32_t lastExponent);
+
+public:
+  Benchmark() = delete;
+  Benchmark(const std::string& name, const Options& options);
+  ~Benchmark();
+
+  // Times each call to function with a host wall clock
+  Result run(const std::string& name, const Parameters& parameters, const Throughput& throughput, std::function<void()> function);
+
+  // Function measures itself and returns elapsed seconds, e.g. summed GPU timestamps
+  Result runTimed(const std::string& name, const Parameters& parameters, const Throughput& throughput, std::function<double()> function);
+
+  const std::vector<Result>& results() const noexcept;
+
+  void save() const;
+
+private:
+  class Impl;
+  std::shared_ptr<Impl> impl_;
+};
+}
+}
+
+#endif // ELASTICIZE_BENCH_BENCHMARK_H_
@@ -27,6 +27,12 @@ public:
   const T* data() const;
   uint64_t size() const;
 
+  // GPU pointer to the first element, e.g. for push constants read through buffer references
+  vk::DeviceAddress deviceAddress() const;
+
+  // Shown by debuggers and profilers when the engine has debug utils enabled
+  void setName(const std::string& name);
+
 private:
   class Impl;
   std::shared_ptr<Impl> impl_;
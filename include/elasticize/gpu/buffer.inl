@@ -29,8 +29,7 @@ public:
 
   ~Impl()
   {
-    auto device = engine_.device();
-    device.destroyBuffer(buffer_);
+    engine_.destroyBuffer(buffer_);
   }
 
   operator vk::Buffer() const noexcept { return buffer_; }
@@ -42,11 +41,24 @@ public:
   const T* data() const { return data_.data(); }
   auto size() const { return data_.size(); }
 
+  auto deviceAddress() const
+  {
+    if (!deviceAddress_)
+      deviceAddress_ = engine_.bufferDeviceAddress(buffer_);
+    return deviceAddress_;
+  }
+
+  void setName(const std::string& name)
+  {
+    engine_.setObjectName(buffer_, name);
+  }
+
 private:
   Engine engine_;
 
   std::vector<T> data_;
   vk::Buffer buffer_;
+  mutable vk::DeviceAddress deviceAddress_ = 0;
 };
 
 template <typename T>
@@ -81,6 +93,12 @@ const T* Buffer<T>::data() const { return impl_->data(); }
 
 template <typename T>
 uint64_t Buffer<T>::size() const { return impl_->size(); }
+
+template <typename T>
+vk::DeviceAddress Buffer<T>::deviceAddress() const { return impl_->deviceAddress(); }
+
+template <typename T>
+void Buffer<T>::setName(const std::string& name) { impl_->setName(name); }
 }
 }
 
@@ -3,19 +3,36 @@
 
 #include <vulkan/vulkan.hpp>
 
+#include <elasticize/gpu/descriptor_set_layout.h>
+
 namespace elastic
 {
 namespace gpu
 {
 class Engine;
-class DescriptorSetLayout;
 
 struct PushConstantRange
 {
+  uint32_t offset = 0;
+  uint32_t size = 0;
 };
 
 class ComputeShader
 {
+public:
+  struct CreateInfo
+  {
+    std::string filepath;
+    DescriptorSetLayout descriptorSetLayout;
+    std::vector<PushConstantRange> pushConstantRanges;
+
+    // Values of layout (constant_id = i), in constant id order
+    std::vector<uint32_t> specializationConstants;
+  };
+
+  // Compiles pipelines concurrently, one vkCreateComputePipelines call per worker thread
+  static std::vector<ComputeShader> createMany(Engine engine, const std::vector<CreateInfo>& createInfos);
+
 public:
   ComputeShader() = delete;
 
@@ -24,14 +41,23 @@ public:
     DescriptorSetLayout descriptorSetLayout,
     const std::vector<PushConstantRange>& pushConstantRanges);
 
+  ComputeShader(Engine engine, const CreateInfo& createInfo);
+
   ~ComputeShader();
 
   vk::PipelineLayout pipelineLayout() const noexcept;
   vk::Pipeline pipeline() const noexcept;
+  DescriptorSetLayout descriptorSetLayout() const noexcept;
+
+  // Defaults to the shader file name, e.g. "count.comp", and labels its dispatches
+  const std::string& name() const noexcept;
+  void setName(const std::string& name);
 
 private:
   class Impl;
   std::shared_ptr<Impl> impl_;
+
+  explicit ComputeShader(std::shared_ptr<Impl> impl);
 };
 }
 }
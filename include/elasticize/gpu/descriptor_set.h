@@ -4,6 +4,7 @@
 #include <vulkan/vulkan.hpp>
 
 #include <elasticize/gpu/buffer.h>
+#include <elasticize/gpu/uniform_buffer.h>
 
 namespace elastic
 {
@@ -14,7 +15,7 @@ class DescriptorSetLayout;
 
 class DescriptorSet
 {
-private:
+public:
   class BufferProxy
   {
   public:
@@ -24,10 +25,24 @@ private:
     BufferProxy(const Buffer<T>& buffer)
       : buffer_(buffer) {}
 
+    // Binds a single element, selected by dynamic offset
+    template <typename T>
+    BufferProxy(const UniformBuffer<T>& buffer)
+      : buffer_(buffer), range_(sizeof(T)) {}
+
     operator vk::Buffer() const noexcept { return buffer_; }
 
+    vk::DescriptorBufferInfo bufferInfo() const noexcept
+    {
+      return vk::DescriptorBufferInfo()
+        .setBuffer(buffer_)
+        .setOffset(0)
+        .setRange(range_);
+    }
+
   private:
     vk::Buffer buffer_;
+    vk::DeviceSize range_ = VK_WHOLE_SIZE;
   };
 
 public:
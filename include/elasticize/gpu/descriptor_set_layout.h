@@ -14,10 +14,16 @@ class DescriptorSetLayout
 public:
   DescriptorSetLayout() = delete;
   DescriptorSetLayout(Engine engine, uint32_t storageBufferCount);
+  // Push descriptor layouts bind buffers inline per dispatch, falling back to cached sets when unsupported
+  DescriptorSetLayout(Engine engine, const std::vector<vk::DescriptorType>& descriptorTypes, bool pushDescriptor = false);
   ~DescriptorSetLayout();
 
   operator vk::DescriptorSetLayout() const noexcept;
 
+  // Descriptor type of each binding, in binding order
+  const std::vector<vk::DescriptorType>& descriptorTypes() const noexcept;
+  bool pushDescriptor() const noexcept;
+
 private:
   class Impl;
   std::shared_ptr<Impl> impl_;
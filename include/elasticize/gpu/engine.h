@@ -1,6 +1,8 @@
 #ifndef ELASTICIZE_GPU_ENGINE_H_
 #define ELASTICIZE_GPU_ENGINE_H_
 
+#include <chrono>
+
 #include <vulkan/vulkan.hpp>
 
 namespace elastic
@@ -15,20 +17,30 @@ namespace gpu
 template <typename T>
 class Buffer;
 
+template <typename T>
+class UniformBuffer;
+
 class Image;
 class Execution;
 class GraphicsShader;
 class ComputeShader;
+class DescriptorSetLayout;
+class DescriptorSet;
 
 class Engine
 {
   template <typename T>
   friend class Buffer;
 
+  template <typename T>
+  friend class UniformBuffer;
+
   friend class Image;
   friend class Execution;
   friend class GraphicsShader;
   friend class ComputeShader;
+  friend class DescriptorSetLayout;
+  friend class DescriptorSet;
 
 public:
   struct Options
@@ -36,9 +48,43 @@ public:
     bool validationLayer = false;
     bool headless = true;
 
+    // Names objects and labels commands through VK_EXT_debug_utils for external profilers.
+    // Compiled in only with VULKAN_VALIDATION or ELASTICIZE_DEBUG_UTILS defined.
+    bool debugUtils = false;
+
     vk::DeviceSize memoryPoolSize = 256ull * 1024 * 1024; // 256MB default
   };
 
+  // Activity since construction or the last resetCounters(), summed over all threads
+  struct Counters
+  {
+    uint64_t submits = 0;
+    uint64_t dispatches = 0;
+    uint64_t draws = 0;
+    uint64_t barriers = 0;
+    uint64_t pipelineBinds = 0;
+    uint64_t descriptorSetAllocations = 0;
+    uint64_t bytesUploaded = 0;
+    uint64_t bytesReadBack = 0;
+    uint64_t bytesCopied = 0;
+    uint64_t fenceWaitNanoseconds = 0; // host time blocked on fences
+  };
+
+  enum class Counter
+  {
+    Submits,
+    Dispatches,
+    Draws,
+    Barriers,
+    PipelineBinds,
+    DescriptorSetAllocations,
+    BytesUploaded,
+    BytesReadBack,
+    BytesCopied,
+    FenceWaitNanoseconds,
+    Count,
+  };
+
 public:
   Engine() = delete;
   explicit Engine(Options options);
@@ -50,15 +96,56 @@ public:
   uint32_t queueIndex() const noexcept;
   vk::Device device() const noexcept;
   vk::CommandPool transientCommandPool() const noexcept;
+
+  // First pool of the engine's descriptor pool chain, created with eFreeDescriptorSet.
+  // Sets allocated from it directly are owned by the caller and must be freed before the engine is destroyed.
+  [[deprecated("DescriptorSet allocates from the engine's pool chain, allocate through it instead")]]
   vk::DescriptorPool descriptorPool() const noexcept;
 
+  bool pushDescriptorSupported() const noexcept;
+  bool bufferDeviceAddressSupported() const noexcept;
+  bool pipelineStatisticsSupported() const noexcept;
+  bool calibratedTimestampsSupported() const noexcept;
+  bool debugUtilsEnabled() const noexcept;
+
+  // Subgroup sizes compute shaders may run with; a device may pick any of them per pipeline or dispatch,
+  // so shared memory sized per subgroup must be sized for the minimum
+  uint32_t minSubgroupSize() const noexcept;
+  uint32_t maxSubgroupSize() const noexcept;
+
+  Counters counters() const noexcept;
+
+  // Returns the counters accumulated so far and starts over from zero
+  Counters resetCounters() noexcept;
+
 private:
   // By friend objects
+  void addCounter(Counter counter, uint64_t value = 1) noexcept;
+
   vk::Buffer createBuffer(vk::DeviceSize size);
+  vk::DeviceAddress bufferDeviceAddress(vk::Buffer buffer) const;
+  void destroyBuffer(vk::Buffer buffer);
 
   void bindImageMemory(vk::Image image);
 
+  vk::DescriptorSet descriptorSet(vk::DescriptorSetLayout layout, const std::vector<vk::DescriptorType>& descriptorTypes, const std::vector<vk::DescriptorBufferInfo>& bufferInfos);
+  void destroyDescriptorSetLayout(vk::DescriptorSetLayout layout);
+
   vk::ShaderModule createShaderModule(const std::string& filepath);
+  vk::PipelineCache pipelineCache() const noexcept;
+  const vk::DispatchLoaderDynamic& dispatchLoader() const noexcept;
+
+  // No-op unless debugUtilsEnabled()
+  void setObjectName(vk::ObjectType objectType, uint64_t handle, const std::string& name);
+
+  template <typename Handle>
+  void setObjectName(Handle handle, const std::string& name)
+  {
+    setObjectName(Handle::objectType, reinterpret_cast<uint64_t>(static_cast<typename Handle::CType>(handle)), name);
+  }
+
+  // Device timestamp and host steady clock sampled together, requires calibratedTimestampsSupported()
+  std::pair<uint64_t, std::chrono::steady_clock::time_point> calibrateTimestamps();
 
   vk::Buffer stagingBuffer() const noexcept;
   void fromStagingBuffer(void* target, vk::DeviceSize srcOffset, vk::DeviceSize size);
@@ -4,6 +4,8 @@
 #include <vulkan/vulkan.hpp>
 
 #include <elasticize/gpu/buffer.h>
+#include <elasticize/gpu/uniform_buffer.h>
+#include <elasticize/gpu/descriptor_set.h>
 
 namespace elastic
 {
@@ -12,17 +14,48 @@ namespace gpu
 class Engine;
 class ComputeShader;
 class GraphicsShader;
-class DescriptorSet;
 class Framebuffer;
 class Swapchain;
 
 class Execution
 {
+public:
+  struct Options
+  {
+    // Wraps every command in timestamp queries, reported after run() and to the global tracer when enabled
+    bool profile = false;
+
+    // Wraps every command in a pipeline statistics query, reported after run()
+    bool pipelineStatistics = false;
+  };
+
+  struct PipelineStatistics
+  {
+    uint64_t inputAssemblyVertices = 0;
+    uint64_t inputAssemblyPrimitives = 0;
+    uint64_t vertexShaderInvocations = 0;
+    uint64_t clippingInvocations = 0;
+    uint64_t clippingPrimitives = 0;
+    uint64_t fragmentShaderInvocations = 0;
+    uint64_t computeShaderInvocations = 0;
+  };
+
+  struct CommandReport
+  {
+    std::string name;
+    double elapsed = 0.; // GPU time in milliseconds
+    PipelineStatistics statistics;
+  };
+
 public:
   Execution() = delete;
   Execution(Engine engine);
+  Execution(Engine engine, const Options& options);
   ~Execution();
 
+  // Names the next recorded command in the report and its debug label, dispatches default to the shader name
+  Execution& name(const std::string& name);
+
   template <typename T>
   Execution& toGpu(const Buffer<T>& buffer)
   {
@@ -37,10 +70,55 @@ public:
     return *this;
   }
 
+  template <typename T>
+  Execution& toGpu(const UniformBuffer<T>& buffer)
+  {
+    if (buffer.size() > 0)
+      toGpu(buffer, buffer.data(), static_cast<vk::DeviceSize>(buffer.stride()) * buffer.size());
+    return *this;
+  }
+
   template <typename T>
   Execution& copy(const Buffer<T>& srcBuffer, const Buffer<T>& dstBuffer)
   {
-    return copy(srcBuffer, dstBuffer, sizeof(T) * srcBuffer.size());
+    return copy(static_cast<vk::Buffer>(srcBuffer), static_cast<vk::Buffer>(dstBuffer), sizeof(T) * srcBuffer.size());
+  }
+
+  // Transfers of the first count elements only
+  template <typename T>
+  Execution& toGpu(const Buffer<T>& buffer, uint64_t count)
+  {
+    return toGpu(buffer, buffer.data(), sizeof(T) * count);
+  }
+
+  template <typename T>
+  Execution& fromGpu(Buffer<T>& buffer, uint64_t count)
+  {
+    return fromGpu(buffer, buffer.data(), sizeof(T) * count);
+  }
+
+  template <typename T>
+  Execution& copy(const Buffer<T>& srcBuffer, const Buffer<T>& dstBuffer, uint64_t count)
+  {
+    return copy(static_cast<vk::Buffer>(srcBuffer), static_cast<vk::Buffer>(dstBuffer), sizeof(T) * count);
+  }
+
+  // Copies count elements from srcIndex on to dstIndex on
+  template <typename T>
+  Execution& copy(const Buffer<T>& srcBuffer, uint64_t srcIndex, const Buffer<T>& dstBuffer, uint64_t dstIndex, uint64_t count)
+  {
+    return copy(static_cast<vk::Buffer>(srcBuffer), static_cast<vk::Buffer>(dstBuffer), sizeof(T) * count, sizeof(T) * srcIndex, sizeof(T) * dstIndex);
+  }
+
+  // Untyped copy of size bytes, e.g. between buffers of different element types
+  Execution& copy(vk::Buffer srcBuffer, vk::Buffer dstBuffer, vk::DeviceSize size, vk::DeviceSize srcOffset = 0, vk::DeviceSize dstOffset = 0);
+
+  // Sets every 32-bit word of the first count elements to value
+  template <typename T>
+  Execution& fill(const Buffer<T>& buffer, uint64_t count, uint32_t value)
+  {
+    static_assert(sizeof(T) % sizeof(uint32_t) == 0, "Elements must be made of 32-bit words");
+    return fill(static_cast<vk::Buffer>(buffer), sizeof(T) * count, value);
   }
 
   template <typename T>
@@ -50,6 +128,29 @@ public:
     return runComputeShader(computeShader, descriptorSet, groupCountX, &pushConstants, sizeof(T));
   }
 
+  // Dynamic offsets select per-object elements of dynamic uniform buffers, in binding order
+  template <typename T>
+  Execution& runComputeShader(ComputeShader computeShader, DescriptorSet descriptorSet, const std::vector<uint32_t>& dynamicOffsets, uint32_t groupCountX,
+    const T& pushConstants)
+  {
+    return runComputeShader(computeShader, descriptorSet, dynamicOffsets, groupCountX, &pushConstants, sizeof(T));
+  }
+
+  // Binds buffers inline with push descriptors, or a cached descriptor set when the layout is not a push layout
+  template <typename T>
+  Execution& runComputeShader(ComputeShader computeShader, const std::vector<DescriptorSet::BufferProxy>& buffers, uint32_t groupCountX,
+    const T& pushConstants)
+  {
+    return runComputeShader(computeShader, buffers, groupCountX, &pushConstants, sizeof(T));
+  }
+
+  // No descriptors bound, buffers are accessed through device addresses in push constants
+  template <typename T>
+  Execution& runComputeShader(ComputeShader computeShader, uint32_t groupCountX, const T& pushConstants)
+  {
+    return runComputeShader(computeShader, groupCountX, &pushConstants, sizeof(T));
+  }
+
   Execution& barrier();
 
   template <typename T>
@@ -61,13 +162,20 @@ public:
   Execution& end();
 
   void run();
+
+  // Per-command GPU timings and statistics of the last run(), in recording order
+  const std::vector<CommandReport>& report() const noexcept;
+
   void present(vk::Semaphore imageAvailableSemaphore, vk::Semaphore renderFinishedSemaphore, vk::Fence renderFinishedFence, Swapchain swapchain, uint32_t imageIndex);
 
 private:
   Execution& toGpu(vk::Buffer buffer, const void* data, vk::DeviceSize size);
   Execution& fromGpu(vk::Buffer buffer, void* data, vk::DeviceSize size);
-  Execution& copy(vk::Buffer srcBuffer, vk::Buffer dstBuffer, vk::DeviceSize size);
+  Execution& fill(vk::Buffer buffer, vk::DeviceSize size, uint32_t value);
   Execution& runComputeShader(ComputeShader computeShader, DescriptorSet descriptorSet, uint32_t groupCountX, const void* pushConstants, uint32_t size);
+  Execution& runComputeShader(ComputeShader computeShader, DescriptorSet descriptorSet, const std::vector<uint32_t>& dynamicOffsets, uint32_t groupCountX, const void* pushConstants, uint32_t size);
+  Execution& runComputeShader(ComputeShader computeShader, const std::vector<DescriptorSet::BufferProxy>& buffers, uint32_t groupCountX, const void* pushConstants, uint32_t size);
+  Execution& runComputeShader(ComputeShader computeShader, uint32_t groupCountX, const void* pushConstants, uint32_t size);
   Execution& draw(GraphicsShader graphicsShader, DescriptorSet descriptorSet, Framebuffer framebuffer, vk::Buffer vertexBuffer, vk::Buffer indexBuffer, uint32_t indexCount);
 
   class Impl;
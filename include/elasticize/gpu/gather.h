@@ -0,0 +1,52 @@
+#ifndef ELASTICIZE_GPU_GATHER_H_
+#define ELASTICIZE_GPU_GATHER_H_
+
+#include <stdexcept>
+#include <string>
+
+#include <vulkan/vulkan.hpp>
+
+#include <elasticize/gpu/buffer.h>
+
+namespace elastic
+{
+namespace gpu
+{
+class Engine;
+class Execution;
+
+// Gathers 32-bit values by index, e.g. structure-of-arrays data by a RadixSort::sortPermutation() permutation.
+// Buffers are passed as device addresses in push constants, so no descriptor set is bound.
+class Gather
+{
+public:
+  // Needs buffer device addresses
+  static bool supported(Engine engine);
+
+public:
+  Gather() = delete;
+  Gather(Engine engine, const std::string& shaderDirpath);
+  ~Gather();
+
+  // Records dst[i] = src[indices[i]] for i < count. T is a 32-bit type and dst must not overlap src.
+  template <typename T>
+  Gather& gather(Execution& execution, const Buffer<T>& src, const Buffer<uint32_t>& indices, const Buffer<T>& dst, uint32_t count)
+  {
+    static_assert(sizeof(T) == sizeof(uint32_t), "Gathered values are 32-bit");
+    if (count > indices.size() || count > dst.size())
+      throw std::runtime_error("Gather of " + std::to_string(count) + " values exceeds the index or destination buffer");
+
+    gather(execution, src.deviceAddress(), indices.deviceAddress(), dst.deviceAddress(), count);
+    return *this;
+  }
+
+private:
+  void gather(Execution& execution, vk::DeviceAddress src, vk::DeviceAddress indices, vk::DeviceAddress dst, uint32_t count);
+
+  class Impl;
+  std::shared_ptr<Impl> impl_;
+};
+}
+}
+
+#endif // ELASTICIZE_GPU_GATHER_H_
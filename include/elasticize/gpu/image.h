@@ -32,6 +32,9 @@ public:
 
   vk::ImageView imageView() const noexcept;
 
+  // Shown by debuggers and profilers when the engine has debug utils enabled
+  void setName(const std::string& name);
+
 private:
   class Impl;
   std::shared_ptr<Impl> impl_;
@@ -0,0 +1,158 @@
+#ifndef ELASTICIZE_GPU_RADIX_SORT_H_
+#define ELASTICIZE_GPU_RADIX_SORT_H_
+
+#include <string>
+#include <optional>
+#include <type_traits>
+
+#include <vulkan/vulkan.hpp>
+
+#include <elasticize/gpu/buffer.h>
+#include <elasticize/gpu/descriptor_set.h>
+#include <elasticize/gpu/validator.h>
+
+namespace elastic
+{
+namespace gpu
+{
+class Engine;
+class Execution;
+class Tuner;
+
+// Element layout of shader/radix_sort/*.comp
+struct KeyValue
+{
+  uint32_t key;
+  uint32_t value;
+};
+
+// Stable LSD radix sort of key/value pairs or keys alone, 8 bits per pass. Small KeyValue sorts
+// are bitonic and merge sorts instead, see Options::blockSortThreshold.
+// Owns its pipelines and scratch buffers, sized once for the largest sort.
+class RadixSort
+{
+public:
+  enum class Algorithm
+  {
+    // count, multi-level scan and distribute dispatches for every digit
+    Multipass,
+
+    // One histogram pass for all digits, then one scatter per digit with decoupled look-back.
+    // KeyValue sorts only, the other element layouts fall back to Multipass
+    Onesweep,
+  };
+
+  struct Options
+  {
+    // Largest count a sort may be recorded with
+    uint32_t maxCount = 0;
+
+    Algorithm algorithm = Algorithm::Multipass;
+
+    // Block size of the scan kernels until tune() picks one. A multiple of the subgroup size, at most its square,
+    // and at least 64; the constructor throws otherwise
+    uint32_t scanBlockSize = 256;
+
+    // Multipass ranks several keys per invocation with subgroup ballots where supported,
+    // instead of four 2-bit local sorts of one key per invocation
+    bool multisplit = true;
+
+    // Multipass skips the passes whose digit is the same for every key, found while counting the first digit,
+    // e.g. the shared high bits of spatially coherent Morton codes
+    bool skipUniformPasses = true;
+
+    // KeyValue sorts of up to blockSortThreshold elements run as one workgroup's bitonic sort in shared memory,
+    // a single dispatch; the threshold is capped at 2048, or 1024 with 16KB of shared memory.
+    // Up to mergeSortThreshold, runs sorted that way are merged pairwise with merge path passes.
+    // Larger sorts and the other element layouts radix sort, 0 disables either path.
+    // These are defaults until tune() measures the device's crossovers.
+    uint32_t blockSortThreshold = 2048;
+    uint32_t mergeSortThreshold = 1u << 16;
+
+    // Allocates the index scratch sortPermutation() needs
+    bool permutation = false;
+
+    // Checks every recorded sort on the GPU, see check()
+    bool validate = false;
+  };
+
+  // Device memory the scratch buffers of a RadixSort created with options take from the pool
+  static vk::DeviceSize scratchSize(const Options& options);
+
+  // Onesweep and Options::multisplit rank keys with subgroup ballots. They need subgroups of at most 128 invocations
+  // with ballot operations in compute shaders, and shared memory for the digit counts of every subgroup at the
+  // device's minimum subgroup size. Without them onesweep throws and multisplit falls back to 2-bit local sorts.
+  static bool subgroupRankingSupported(Engine engine);
+
+public:
+  RadixSort() = delete;
+  RadixSort(Engine engine, const std::string& shaderDirpath, const Options& options);
+  ~RadixSort();
+
+  uint32_t maxCount() const noexcept;
+  uint32_t scanBlockSize() const noexcept;
+  bool multisplit() const noexcept;
+
+  // Records the sort of the first count elements in place, with keys below 2^keyBits.
+  // Recorded commands reuse the scratch buffers, so sorts of one RadixSort run one at a time.
+  RadixSort& sort(Execution& execution, const Buffer<KeyValue>& keyValues, uint32_t count, uint32_t keyBits = 32);
+
+  // Sorts keys alone, e.g. for deduplication. Key is uint32_t, int32_t, float or uint64_t.
+  // Floats order by value with negative NaNs first and positive NaNs last; keyBits may only trim unsigned keys.
+  template <typename Key>
+  RadixSort& sortKeys(Execution& execution, const Buffer<Key>& keys, uint32_t count, uint32_t keyBits = 8 * sizeof(Key))
+  {
+    sort(execution, layout<Key>(), keys, std::nullopt, count, keyBits);
+    return *this;
+  }
+
+  // Sorts keys in place and writes the original index of each sorted key to permutation, to gather structure-of-arrays data.
+  // Needs Options::permutation.
+  template <typename Key>
+  RadixSort& sortPermutation(Execution& execution, const Buffer<Key>& keys, const Buffer<uint32_t>& permutation, uint32_t count, uint32_t keyBits = 8 * sizeof(Key))
+  {
+    sort(execution, layout<Key>(), keys, DescriptorSet::BufferProxy(permutation), count, keyBits);
+    return *this;
+  }
+
+  // Picks the multipass scan block size, then blockSortThreshold and mergeSortThreshold, with the tuner,
+  // measuring sorts of the host data of keyValues on first use. Results are cached per algorithm and multipass
+  // ranking, and remeasured when the shaders of the measured path change.
+  void tune(Tuner& tuner, const Buffer<KeyValue>& keyValues, uint32_t count, uint32_t keyBits = 32);
+
+  // With Options::validate, throws std::runtime_error if the last recorded sort is wrong, once it ran
+  void check() const;
+
+private:
+  // Words per element and key type, selecting the shader variant
+  struct Layout
+  {
+    uint32_t elementWords;
+    Validator::KeyType keyType;
+  };
+
+  template <typename Key>
+  static Layout layout()
+  {
+    static_assert(std::is_same_v<Key, uint32_t> || std::is_same_v<Key, int32_t> || std::is_same_v<Key, float> || std::is_same_v<Key, uint64_t>,
+      "Keys are uint32_t, int32_t, float or uint64_t");
+
+    if constexpr (std::is_same_v<Key, int32_t>)
+      return { 1, Validator::KeyType::Int };
+    else if constexpr (std::is_same_v<Key, float>)
+      return { 1, Validator::KeyType::Float };
+    else if constexpr (std::is_same_v<Key, uint64_t>)
+      return { 2, Validator::KeyType::Uint64 };
+    else
+      return { 1, Validator::KeyType::Uint };
+  }
+
+  void sort(Execution& execution, const Layout& layout, DescriptorSet::BufferProxy elements, std::optional<DescriptorSet::BufferProxy> permutation, uint32_t count, uint32_t keyBits);
+
+  class Impl;
+  std::shared_ptr<Impl> impl_;
+};
+}
+}
+
+#endif // ELASTICIZE_GPU_RADIX_SORT_H_
@@ -0,0 +1,112 @@
+#ifndef ELASTICIZE_GPU_SCAN_H_
+#define ELASTICIZE_GPU_SCAN_H_
+
+#include <string>
+#include <type_traits>
+
+#include <vulkan/vulkan.hpp>
+
+#include <elasticize/gpu/buffer.h>
+#include <elasticize/gpu/descriptor_set.h>
+
+namespace elastic
+{
+namespace gpu
+{
+class Engine;
+class Execution;
+
+// Prefix sum, max or min of 32-bit values, e.g. output offsets of a compaction, CSR row offsets or allocations.
+// Owns its pipelines and scratch buffer, sized once for the largest scan.
+class Scan
+{
+public:
+  enum class Algorithm
+  {
+    // Tiles scanned and their totals scanned level by level, then added back down: 2 log_1024(n) dispatches
+    MultiLevel,
+
+    // One dispatch, each tile looks back at the prefixes earlier tiles publish
+    DecoupledLookBack,
+  };
+
+  enum class Operator
+  {
+    Sum, // wraps for integers
+    Max,
+    Min,
+  };
+
+  struct Options
+  {
+    // Largest count a scan may be recorded with
+    uint32_t maxCount = 0;
+
+    Algorithm algorithm = Algorithm::MultiLevel;
+  };
+
+  // Values a workgroup scans, TILE_SIZE in shader/scan/*.comp
+  static constexpr uint32_t tileSize = 1024;
+
+  // Device memory the scratch buffer of a Scan created with options takes from the pool
+  static vk::DeviceSize scratchSize(const Options& options);
+
+  // Needs subgroup arithmetic in compute shaders, of any subgroup size
+  static bool supported(Engine engine);
+
+public:
+  Scan() = delete;
+  Scan(Engine engine, const std::string& shaderDirpath, const Options& options);
+  ~Scan();
+
+  uint32_t maxCount() const noexcept;
+
+  // Records output[i] = input[0] op ... op input[i - 1]; output[0] is the identity, 0 for sums, the lowest value for max and the highest for min.
+  // T is uint32_t, int32_t or float, and output may be input. Float sums round differently than a sequential sum.
+  template <typename T>
+  Scan& exclusive(Execution& execution, const Buffer<T>& input, const Buffer<T>& output, uint32_t count, Operator op = Operator::Sum)
+  {
+    scan(execution, valueType<T>(), op, input, output, count, true);
+    return *this;
+  }
+
+  // Records output[i] = input[0] op ... op input[i]
+  template <typename T>
+  Scan& inclusive(Execution& execution, const Buffer<T>& input, const Buffer<T>& output, uint32_t count, Operator op = Operator::Sum)
+  {
+    scan(execution, valueType<T>(), op, input, output, count, false);
+    return *this;
+  }
+
+private:
+  // VALUE_TYPE in shader/scan/*.comp
+  enum class ValueType
+  {
+    Uint,
+    Int,
+    Float,
+  };
+
+  template <typename T>
+  static ValueType valueType()
+  {
+    static_assert(std::is_same_v<T, uint32_t> || std::is_same_v<T, int32_t> || std::is_same_v<T, float>,
+      "Values are uint32_t, int32_t or float");
+
+    if constexpr (std::is_same_v<T, int32_t>)
+      return ValueType::Int;
+    else if constexpr (std::is_same_v<T, float>)
+      return ValueType::Float;
+    else
+      return ValueType::Uint;
+  }
+
+  void scan(Execution& execution, ValueType valueType, Operator op, DescriptorSet::BufferProxy input, DescriptorSet::BufferProxy output, uint32_t count, bool exclusive);
+
+  class Impl;
+  std::shared_ptr<Impl> impl_;
+};
+}
+}
+
+#endif // ELASTICIZE_GPU_SCAN_H_
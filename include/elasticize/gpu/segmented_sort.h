@@ -0,0 +1,56 @@
+#ifndef ELASTICIZE_GPU_SEGMENTED_SORT_H_
+#define ELASTICIZE_GPU_SEGMENTED_SORT_H_
+
+#include <string>
+
+#include <vulkan/vulkan.hpp>
+
+#include <elasticize/gpu/buffer.h>
+#include <elasticize/gpu/radix_sort.h>
+
+namespace elastic
+{
+namespace gpu
+{
+class Engine;
+class Execution;
+
+// Stable sort of every segment of a key/value array, e.g. contacts per body or particles per grid cell.
+// Small segments are packed into tiles and sorted in shared memory by a single dispatch. The elements of all
+// segments larger than a tile are gathered and radix sorted together by segment and key, so the dispatch count
+// does not grow with the number of segments. That sort uses 64-bit keys with a permutation, always multipass.
+class SegmentedSort
+{
+public:
+  struct Options
+  {
+    // Largest total count and segment count a sort may be recorded with
+    uint32_t maxCount = 0;
+    uint32_t maxSegments = 0;
+  };
+
+  // Elements a workgroup sorts in shared memory, TILE_SIZE in shader/segmented_sort/block_sort.comp
+  static constexpr uint32_t tileSize = 1024;
+
+  // Device memory the scratch buffers of a SegmentedSort created with options take from the pool
+  static vk::DeviceSize scratchSize(const Options& options);
+
+public:
+  SegmentedSort() = delete;
+  SegmentedSort(Engine engine, const std::string& shaderDirpath, const Options& options);
+  ~SegmentedSort();
+
+  // Records the sort of keyValues[offsets[i], offsets[i + 1]) for every segment i < segmentCount, with keys below 2^keyBits.
+  // Segments are planned on the host while recording, so offsets must hold the segmentCount + 1 offsets in its
+  // host data at that point; recording uploads them over the device copy. Offsets computed on the GPU, e.g. by Scan,
+  // need a fromGpu() run before recording, and later changes to them need the sort recorded again.
+  SegmentedSort& sort(Execution& execution, const Buffer<KeyValue>& keyValues, const Buffer<uint32_t>& offsets, uint32_t segmentCount, uint32_t keyBits = 32);
+
+private:
+  class Impl;
+  std::shared_ptr<Impl> impl_;
+};
+}
+}
+
+#endif // ELASTICIZE_GPU_SEGMENTED_SORT_H_
@@ -0,0 +1,69 @@
+#ifndef ELASTICIZE_GPU_TUNER_H_
+#define ELASTICIZE_GPU_TUNER_H_
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <elasticize/gpu/engine.h>
+#include <elasticize/gpu/compute_shader.h>
+
+namespace elastic
+{
+namespace gpu
+{
+class Execution;
+
+// Picks kernel variants by measuring them on first use and remembers the winners per device.
+// A variant is the list of specialization constant values, in constant id order.
+class Tuner
+{
+public:
+  using Variant = std::vector<uint32_t>;
+
+  struct Options
+  {
+    // Winners are loaded from and appended to this file, not persisted when empty
+    std::string cacheFilepath = "elasticize_tuning.txt";
+
+    // Each candidate is measured this many times and ranked by its median
+    uint32_t repetitions = 5;
+
+    // Called with the median seconds of each candidate as it is measured, e.g. to print tuning progress
+    std::function<void(const std::string& name, const Variant& variant, double seconds)> measured;
+  };
+
+  // Sum of profiled command times in seconds, requires Execution::Options::profile
+  static double gpuElapsed(const Execution& execution);
+
+public:
+  Tuner() = delete;
+  explicit Tuner(Engine engine);
+  Tuner(Engine engine, const Options& options);
+  ~Tuner();
+
+  // Device UUID and driver version, the key winners are stored under
+  const std::string& deviceKey() const noexcept;
+
+  // Cached winner for name on this device and these SPIR-V binaries, or an empty variant when not tuned yet
+  Variant lookup(const std::string& name, const std::vector<std::string>& shaderFilepaths = {}) const;
+
+  // Returns the cached winner, otherwise measures every candidate with measure(variant) returning
+  // seconds, caches the fastest and persists it. Names must not contain whitespace.
+  // Winners are stored with a hash of the SPIR-V files of shaderFilepaths, so rebuilt shaders are tuned again.
+  Variant tune(const std::string& name, const std::vector<Variant>& candidates, std::function<double(const Variant&)> measure,
+    const std::vector<std::string>& shaderFilepaths = {});
+
+  // Creates the shader with the tuned specialization constants of name, or createInfo's own if not tuned.
+  // The winner must have been tuned with createInfo.filepath as its only shader file.
+  ComputeShader computeShader(const std::string& name, ComputeShader::CreateInfo createInfo) const;
+
+private:
+  class Impl;
+  std::shared_ptr<Impl> impl_;
+};
+}
+}
+
+#endif // ELASTICIZE_GPU_TUNER_H_
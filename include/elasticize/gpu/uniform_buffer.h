@@ -0,0 +1,49 @@
+#ifndef ELASTICIZE_GPU_UNIFORM_BUFFER_H_
+#define ELASTICIZE_GPU_UNIFORM_BUFFER_H_
+
+#include <vulkan/vulkan.hpp>
+
+namespace elastic
+{
+namespace gpu
+{
+class Engine;
+
+// One uniform buffer holding a T per object, bound once as a dynamic uniform buffer and selected by dynamic offset
+template <typename T>
+class UniformBuffer
+{
+public:
+  UniformBuffer() = delete;
+  UniformBuffer(Engine engine, uint32_t capacity);
+  ~UniformBuffer();
+
+  operator vk::Buffer() const noexcept;
+
+  // Sub-allocates a slot, valid until the next reset(), e.g. once per object per frame
+  uint32_t allocate();
+  void reset();
+
+  T& operator [] (uint32_t index);
+  const T& operator [] (uint32_t index) const;
+
+  // Dynamic offset of a slot, passed when binding the descriptor set
+  uint32_t offset(uint32_t index) const;
+
+  uint32_t stride() const;
+  uint32_t capacity() const;
+  uint32_t size() const;
+
+  // Host copy of the allocated slots, stride bytes each
+  const void* data() const;
+
+private:
+  class Impl;
+  std::shared_ptr<Impl> impl_;
+};
+}
+}
+
+#include <elasticize/gpu/uniform_buffer.inl>
+
+#endif // ELASTICIZE_GPU_UNIFORM_BUFFER_H_
@@ -0,0 +1,116 @@
+#ifndef ELASTICIZE_GPU_UNIFORM_BUFFER_INL_
+#define ELASTICIZE_GPU_UNIFORM_BUFFER_INL_
+
+#include <type_traits>
+#include <algorithm>
+
+#include <elasticize/gpu/engine.h>
+
+namespace elastic
+{
+namespace gpu
+{
+template <typename T>
+class UniformBuffer<T>::Impl
+{
+  static_assert(std::is_trivially_copyable<T>::value, "Uniform buffer element must be trivially copyable");
+
+public:
+  Impl() = delete;
+
+  Impl(Engine engine, uint32_t capacity)
+    : engine_(engine)
+    , capacity_(capacity)
+  {
+    const auto limits = engine.physicalDevice().getProperties().limits;
+    if (sizeof(T) > limits.maxUniformBufferRange)
+      throw std::runtime_error("Uniform buffer element exceeds maxUniformBufferRange");
+
+    // Each slot starts at a valid dynamic offset
+    vk::DeviceSize alignment = std::max<vk::DeviceSize>(limits.minUniformBufferOffsetAlignment, alignof(T));
+    stride_ = static_cast<uint32_t>((sizeof(T) + alignment - 1) / alignment * alignment);
+
+    data_.resize(static_cast<size_t>(stride_) * capacity_);
+    buffer_ = engine.createBuffer(static_cast<vk::DeviceSize>(stride_) * capacity_);
+  }
+
+  ~Impl()
+  {
+    engine_.destroyBuffer(buffer_);
+  }
+
+  operator vk::Buffer() const noexcept { return buffer_; }
+
+  uint32_t allocate()
+  {
+    if (size_ == capacity_)
+      throw std::runtime_error("Uniform buffer is full");
+
+    return size_++;
+  }
+
+  void reset() { size_ = 0; }
+
+  T& operator [] (uint32_t index) { return *reinterpret_cast<T*>(data_.data() + offset(index)); }
+  const T& operator [] (uint32_t index) const { return *reinterpret_cast<const T*>(data_.data() + offset(index)); }
+
+  uint32_t offset(uint32_t index) const { return stride_ * index; }
+
+  auto stride() const { return stride_; }
+  auto capacity() const { return capacity_; }
+  auto size() const { return size_; }
+
+  const void* data() const { return data_.data(); }
+
+private:
+  Engine engine_;
+
+  uint32_t capacity_ = 0;
+  uint32_t stride_ = 0;
+  uint32_t size_ = 0;
+  std::vector<uint8_t> data_;
+  vk::Buffer buffer_;
+};
+
+template <typename T>
+UniformBuffer<T>::UniformBuffer(Engine engine, uint32_t capacity)
+  : impl_(std::make_shared<Impl>(engine, capacity))
+{
+}
+
+template <typename T>
+UniformBuffer<T>::~UniformBuffer() = default;
+
+template <typename T>
+UniformBuffer<T>::operator vk::Buffer() const noexcept { return *impl_; }
+
+template <typename T>
+uint32_t UniformBuffer<T>::allocate() { return impl_->allocate(); }
+
+template <typename T>
+void UniformBuffer<T>::reset() { impl_->reset(); }
+
+template <typename T>
+T& UniformBuffer<T>::operator [] (uint32_t index) { return (*impl_)[index]; }
+
+template <typename T>
+const T& UniformBuffer<T>::operator [] (uint32_t index) const { return (*impl_)[index]; }
+
+template <typename T>
+uint32_t UniformBuffer<T>::offset(uint32_t index) const { return impl_->offset(index); }
+
+template <typename T>
+uint32_t UniformBuffer<T>::stride() const { return impl_->stride(); }
+
+template <typename T>
+uint32_t UniformBuffer<T>::capacity() const { return impl_->capacity(); }
+
+template <typename T>
+uint32_t UniformBuffer<T>::size() const { return impl_->size(); }
+
+template <typename T>
+const void* UniformBuffer<T>::data() const { return impl_->data(); }
+}
+}
+
+#endif // ELASTICIZE_GPU_UNIFORM_BUFFER_INL_
@@ -0,0 +1,108 @@
+#ifndef ELASTICIZE_GPU_VALIDATOR_H_
+#define ELASTICIZE_GPU_VALIDATOR_H_
+
+#include <string>
+
+#include <vulkan/vulkan.hpp>
+
+#include <elasticize/gpu/buffer.h>
+#include <elasticize/gpu/descriptor_set.h>
+
+namespace elastic
+{
+namespace gpu
+{
+class Engine;
+class Execution;
+
+// Checks sort and scan results on the GPU, reducing them to a few counters for readback.
+// Checks read what commands before the last barrier wrote.
+class Validator
+{
+public:
+  enum class KeyType
+  {
+    Uint,
+    Int,
+    Float,
+    Uint64, // first two words, low word first
+  };
+
+  // Layout shared with shader/validate/*.comp
+  struct Result
+  {
+    uint32_t unsorted = 0;               // elements with a key greater than the next one
+    uint32_t firstUnsorted = ~0u;
+    uint32_t scanMismatches = 0;         // outputs not equal to the previous output plus input
+    uint32_t firstScanMismatch = ~0u;
+    uint32_t checksumSum[2] = { 0, 0 };  // order-independent hashes, per checksum slot
+    uint32_t checksumXor[2] = { 0, 0 };
+
+    bool sorted() const noexcept { return unsorted == 0; }
+    bool scanConsistent() const noexcept { return scanMismatches == 0; }
+
+    // Slots 0 and 1 hashed the same elements, up to order
+    bool permutation() const noexcept
+    {
+      return checksumSum[0] == checksumSum[1] && checksumXor[0] == checksumXor[1];
+    }
+  };
+
+public:
+  Validator() = delete;
+  Validator(Engine engine, const std::string& shaderDirpath);
+  ~Validator();
+
+  // Uploads a cleared result, recorded before the checks of an execution
+  Validator& begin(Execution& execution);
+
+  // Key is the first 32-bit word of each element, or the first two for Uint64
+  template <typename T>
+  Validator& isSorted(Execution& execution, const Buffer<T>& buffer, uint32_t count, KeyType keyType = KeyType::Uint)
+  {
+    static_assert(sizeof(T) % sizeof(uint32_t) == 0, "Elements must be made of 32-bit words");
+    return isSorted(execution, DescriptorSet::BufferProxy(buffer), count, sizeof(T) / sizeof(uint32_t), keyType);
+  }
+
+  // Keys only need to be sorted within each segment [offsets[i], offsets[i + 1]) for i < segmentCount, e.g. after
+  // SegmentedSort, with the offsets on the GPU
+  template <typename T>
+  Validator& isSegmentSorted(Execution& execution, const Buffer<T>& buffer, const Buffer<uint32_t>& offsets, uint32_t segmentCount, uint32_t count, KeyType keyType = KeyType::Uint)
+  {
+    static_assert(sizeof(T) % sizeof(uint32_t) == 0, "Elements must be made of 32-bit words");
+    return isSegmentSorted(execution, DescriptorSet::BufferProxy(buffer), offsets, segmentCount, count, sizeof(T) / sizeof(uint32_t), keyType);
+  }
+
+  // Hashes whole elements into slot 0 or 1, e.g. before and after sorting in place
+  template <typename T>
+  Validator& checksum(Execution& execution, const Buffer<T>& buffer, uint32_t count, uint32_t slot)
+  {
+    static_assert(sizeof(T) % sizeof(uint32_t) == 0, "Elements must be made of 32-bit words");
+    return checksum(execution, DescriptorSet::BufferProxy(buffer), count, sizeof(T) / sizeof(uint32_t), slot);
+  }
+
+  // Untyped versions of the above, elements of stride 32-bit words
+  Validator& isSorted(Execution& execution, DescriptorSet::BufferProxy buffer, uint32_t count, uint32_t stride, KeyType keyType);
+  Validator& isSegmentSorted(Execution& execution, DescriptorSet::BufferProxy buffer, const Buffer<uint32_t>& offsets, uint32_t segmentCount, uint32_t count, uint32_t stride, KeyType keyType);
+  Validator& checksum(Execution& execution, DescriptorSet::BufferProxy buffer, uint32_t count, uint32_t stride, uint32_t slot);
+
+  // Output is the exclusive or inclusive sum scan of input
+  Validator& scan(Execution& execution, const Buffer<uint32_t>& input, const Buffer<uint32_t>& output, uint32_t count, bool exclusive = true);
+
+  // Reads the result back, recorded after the checks
+  Validator& end(Execution& execution);
+
+  // Valid once the execution recorded between begin() and end() ran
+  const Result& result() const;
+
+  // Throws std::runtime_error describing every failed check recorded since begin()
+  void check() const;
+
+private:
+  class Impl;
+  std::shared_ptr<Impl> impl_;
+};
+}
+}
+
+#endif // ELASTICIZE_GPU_VALIDATOR_H_
@@ -0,0 +1,70 @@
+#ifndef ELASTICIZE_UTILS_TRACE_H_
+#define ELASTICIZE_UTILS_TRACE_H_
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace elastic
+{
+namespace utils
+{
+// Collects CPU and GPU zones into one timeline, written as Chrome trace JSON (chrome://tracing, Perfetto)
+class Tracer
+{
+public:
+  using Clock = std::chrono::steady_clock;
+  using TimePoint = Clock::time_point;
+
+  // GPU zones are placed on their own track
+  static constexpr uint32_t gpuTrack = 0xffffffffu;
+
+public:
+  // Process-wide tracer, disabled until enable() is called
+  static Tracer& global();
+
+  Tracer();
+  ~Tracer();
+
+  void enable(bool enabled = true) noexcept;
+  bool enabled() const noexcept;
+
+  // Scoped zones on the calling thread's track
+  void begin(const std::string& name);
+  void end();
+
+  // Zone with known start and end, e.g. from calibrated GPU timestamps
+  void zone(const std::string& name, uint32_t track, TimePoint begin, TimePoint end);
+
+  void clear();
+  void save(const std::string& filepath) const;
+
+private:
+  friend class TraceScope;
+
+  // end() for destructors, ignoring an empty stack, e.g. after a stray manual end()
+  void endNoThrow() noexcept;
+
+  class Impl;
+  std::shared_ptr<Impl> impl_;
+};
+
+// Records a zone on the global tracer for the lifetime of the object
+class TraceScope
+{
+public:
+  TraceScope() = delete;
+  explicit TraceScope(const std::string& name);
+  ~TraceScope();
+
+  TraceScope(const TraceScope&) = delete;
+  TraceScope& operator = (const TraceScope&) = delete;
+
+private:
+  bool enabled_ = false;
+};
+}
+}
+
+#endif // ELASTICIZE_UTILS_TRACE_H_
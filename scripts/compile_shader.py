@@ -3,6 +3,17 @@ import os
 import glob
 import functools
 import operator
+import re
+
+# files included with #include "...", recursively, relative to the including file
+def included_filenames(filename, visited):
+  with open(filename) as f:
+    for included in re.findall(r'^\s*#include\s+"([^"]+)"', f.read(), re.MULTILINE):
+      included = os.path.abspath(os.path.join(os.path.dirname(filename), included))
+      if included not in visited and os.path.exists(included):
+        visited.add(included)
+        included_filenames(included, visited)
+  return visited
 
 if __name__ == "__main__":
   if len(sys.argv) >= 2:
@@ -17,7 +28,8 @@ if __name__ == "__main__":
     # compare change date
     target_filename = f'{filename}.spv'
 
-    source_date = os.path.getmtime(filename)
+    # shared .glsl includes are not compiled on their own, but rebuild every shader including them
+    source_date = max([os.path.getmtime(path) for path in included_filenames(filename, {filename})])
     target_date = os.path.getmtime(target_filename) if os.path.exists(target_filename) else 0.
 
     if source_date > target_date:
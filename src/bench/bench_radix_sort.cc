@@ -3,175 +3,397 @@
 #include <string>
 #include <iomanip>
 #include <execution>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
 
 #include <elasticize/gpu/engine.h>
 #include <elasticize/gpu/buffer.h>
-#include <elasticize/gpu/descriptor_set_layout.h>
-#include <elasticize/gpu/descriptor_set.h>
-#include <elasticize/gpu/compute_shader.h>
 #include <elasticize/gpu/execution.h>
+#include <elasticize/gpu/tuner.h>
+#include <elasticize/gpu/radix_sort.h>
+#include <elasticize/gpu/validator.h>
 #include <elasticize/utils/timer.h>
+#include <elasticize/utils/trace.h>
+#include <elasticize/bench/benchmark.h>
 
-int main()
+namespace
+{
+constexpr int keyBits = 30; // for 10-bit each component morton code
+
+// Spreads the lower 10 bits of v to every third bit
+uint32_t expandBits(uint32_t v)
+{
+  v = (v * 0x00010001u) & 0xFF0000FFu;
+  v = (v * 0x00000101u) & 0x0F00F00Fu;
+  v = (v * 0x00000011u) & 0xC30C30C3u;
+  v = (v * 0x00000005u) & 0x49249249u;
+  return v;
+}
+
+// 30-bit Morton code of a point in the unit cube
+uint32_t morton(float x, float y, float z)
+{
+  const auto quantize = [](float v)
+  {
+    return static_cast<uint32_t>(std::min(std::max(v * 1024.f, 0.f), 1023.f));
+  };
+  return (expandBits(quantize(x)) << 2) | (expandBits(quantize(y)) << 1) | expandBits(quantize(z));
+}
+
+struct Point
+{
+  float x;
+  float y;
+  float z;
+};
+
+// Points around a few gaussian clusters, like particles or bodies in a scene
+std::vector<Point> clusteredPoints(uint32_t n, std::mt19937& gen)
+{
+  constexpr int clusterCount = 16;
+
+  std::uniform_real_distribution<float> center(0.1f, 0.9f);
+  std::normal_distribution<float> offset(0.f, 0.02f);
+  std::uniform_int_distribution<int> cluster(0, clusterCount - 1);
+
+  std::vector<Point> centers(clusterCount);
+  for (auto& c : centers)
+    c = { center(gen), center(gen), center(gen) };
+
+  std::vector<Point> points(n);
+  for (auto& point : points)
+  {
+    const auto& c = centers[cluster(gen)];
+    point = { c.x + offset(gen), c.y + offset(gen), c.z + offset(gen) };
+  }
+  return points;
+}
+
+const std::vector<std::string> distributions = {
+  "uniform",
+  "sorted",
+  "reverse",
+  "few_unique",
+  "all_equal",
+  "small_range",
+  "morton_clustered",
+  "morton_perturbed",
+};
+
+std::vector<uint32_t> generateKeys(const std::string& distribution, uint32_t n, std::mt19937& gen)
+{
+  std::uniform_int_distribution<uint32_t> uniform(0, (1u << keyBits) - 1);
+
+  std::vector<uint32_t> keys(n);
+  if (distribution == "uniform" || distribution == "sorted" || distribution == "reverse")
+  {
+    for (auto& key : keys)
+      key = uniform(gen);
+
+    if (distribution == "sorted")
+      std::sort(keys.begin(), keys.end());
+    else if (distribution == "reverse")
+      std::sort(keys.begin(), keys.end(), std::greater<uint32_t>());
+  }
+  else if (distribution == "few_unique")
+  {
+    std::vector<uint32_t> values(16);
+    for (auto& value : values)
+      value = uniform(gen);
+
+    std::uniform_int_distribution<size_t> index(0, values.size() - 1);
+    for (auto& key : keys)
+      key = values[index(gen)];
+  }
+  else if (distribution == "all_equal")
+  {
+    std::fill(keys.begin(), keys.end(), uniform(gen));
+  }
+  else if (distribution == "small_range")
+  {
+    // Only the low 12 bits differ, the upper digits are shared by every key
+    const auto base = uniform(gen) & ~0xFFFu;
+    for (auto& key : keys)
+      key = base | (uniform(gen) & 0xFFFu);
+  }
+  else if (distribution == "morton_clustered")
+  {
+    const auto points = clusteredPoints(n, gen);
+    for (uint32_t i = 0; i < n; i++)
+      keys[i] = morton(points[i].x, points[i].y, points[i].z);
+  }
+  else if (distribution == "morton_perturbed")
+  {
+    // Last frame's order, after every point moved a little
+    auto points = clusteredPoints(n, gen);
+    std::sort(points.begin(), points.end(), [](const Point& lhs, const Point& rhs)
+      {
+        return morton(lhs.x, lhs.y, lhs.z) < morton(rhs.x, rhs.y, rhs.z);
+      });
+
+    std::normal_distribution<float> velocity(0.f, 0.001f);
+    for (uint32_t i = 0; i < n; i++)
+      keys[i] = morton(points[i].x + velocity(gen), points[i].y + velocity(gen), points[i].z + velocity(gen));
+  }
+  else
+    throw std::runtime_error("Unknown key distribution: " + distribution);
+
+  return keys;
+}
+}
+
+int main(int argc, char** argv)
 {
   try
   {
+    constexpr int minExponent = 8;
+    constexpr int maxExponent = 26;
+    constexpr uint32_t maxN = 1u << maxExponent;
+
+    using elastic::gpu::KeyValue;
+    using elastic::gpu::RadixSort;
+
+    RadixSort::Options multipassOptions;
+    multipassOptions.maxCount = maxN;
+    multipassOptions.algorithm = RadixSort::Algorithm::Multipass;
+
+    // 2-bit local sorts of one key per invocation, compared against ballot ranking where that is supported
+    RadixSort::Options twoBitOptions = multipassOptions;
+    twoBitOptions.multisplit = false;
+
+    // Every pass runs, to compare against skipping the passes whose digit is uniform
+    RadixSort::Options noSkipOptions = multipassOptions;
+    noSkipOptions.skipUniformPasses = false;
+
+    // Radix sorts small arrays too, the crossover with the bitonic and merge sort paths sets their thresholds
+    RadixSort::Options radixOnlyOptions = multipassOptions;
+    radixOnlyOptions.blockSortThreshold = 0;
+    radixOnlyOptions.mergeSortThreshold = 0;
+
+    RadixSort::Options onesweepOptions;
+    onesweepOptions.maxCount = maxN;
+    onesweepOptions.algorithm = RadixSort::Algorithm::Onesweep;
+
+    // Buffers are allocated once for the largest size, the pool does not reclaim memory
     elastic::gpu::Engine::Options options;
     options.headless = true;
-    options.validationLayer = true;
-    options.memoryPoolSize = 256 * 1024 * 1024; // 256MB
-    elastic::gpu::Engine engine(options);
+    options.memoryPoolSize = sizeof(KeyValue) * maxN + RadixSort::scratchSize(multipassOptions) + RadixSort::scratchSize(twoBitOptions) + RadixSort::scratchSize(noSkipOptions) + RadixSort::scratchSize(radixOnlyOptions) + RadixSort::scratchSize(onesweepOptions) + 64ull * 1024 * 1024;
+    elastic::gpu::Engine engine(elastic::bench::Benchmark::engineOptions(options));
+
+    elastic::bench::Benchmark benchmark("radix_sort", elastic::bench::Benchmark::parseArguments(argc, argv));
+
+    // Reads every sorted array back and compares it on the CPU, on top of the GPU validation
+    const auto fullValidation = std::any_of(argv + 1, argv + argc, [](const char* argument) { return std::strcmp(argument, "--full-validation") == 0; });
 
     std::cout << "Engine started!" << std::endl;
 
-    constexpr int n = 1000000;
-    constexpr int keyBits = 30; // for 10-bit each component morton code
-    constexpr int BLOCK_SIZE = 256;
-    constexpr int RADIX_SIZE = 256;
-    constexpr int RADIX_BITS = 8;
+    elastic::gpu::Buffer<KeyValue> arrayBuffer(engine, maxN);
+    arrayBuffer.setName("radix_sort_array");
 
-    std::mt19937 gen(1234);
-    std::uniform_int_distribution<uint32_t> distribution(0, (1 << keyBits) - 1);
+    const std::string shaderDirpath = "C:\\workspace\\elasticize\\src\\elasticize\\shader";
 
-    struct KeyValue
+    // Benchmark case name and sorter of each GPU algorithm available on this device
+    struct GpuSort
     {
-      uint32_t key;
-      uint32_t value;
-
-      bool operator != (const KeyValue& rhs) const
-      {
-        return key != rhs.key || value != rhs.value;
-      }
+      std::string name;
+      RadixSort radixSort;
     };
+    std::vector<GpuSort> gpuSorts;
+    gpuSorts.push_back({ "gpu_radix_sort", RadixSort(engine, shaderDirpath, multipassOptions) });
+    if (gpuSorts.front().radixSort.multisplit())
+      gpuSorts.push_back({ "gpu_radix_sort_2bit", RadixSort(engine, shaderDirpath, twoBitOptions) });
+    else
+      std::cout << "Multisplit ranking not supported on this device" << std::endl;
+    gpuSorts.push_back({ "gpu_radix_sort_no_skip", RadixSort(engine, shaderDirpath, noSkipOptions) });
+    gpuSorts.push_back({ "gpu_radix_sort_radix_only", RadixSort(engine, shaderDirpath, radixOnlyOptions) });
+    if (RadixSort::subgroupRankingSupported(engine))
+      gpuSorts.push_back({ "gpu_onesweep_sort", RadixSort(engine, shaderDirpath, onesweepOptions) });
+    else
+      std::cout << "Onesweep radix sort not supported on this device" << std::endl;
 
-    std::vector<KeyValue> buffer(n);
-    for (uint32_t i = 0; i < n; i++)
-      buffer[i] = { distribution(gen), i };
-
-    elastic::gpu::Buffer<KeyValue> arrayBuffer(engine, n);
-    elastic::gpu::Buffer<KeyValue> outBuffer(engine, n);
-    for (int i = 0; i < n; i++)
-      arrayBuffer[i] = buffer[i];
+    elastic::gpu::Validator validator(engine, shaderDirpath);
 
-    const auto alignedSize = (n + BLOCK_SIZE - 1) / BLOCK_SIZE * BLOCK_SIZE;
-    uint32_t counterSize = 0;
-    uint32_t simdSize = alignedSize;
-    do
+    const auto byKey = [](const KeyValue& lhs, const KeyValue& rhs)
     {
-      counterSize += simdSize;
-      simdSize = (simdSize + BLOCK_SIZE - 1) / BLOCK_SIZE;
-    } while (simdSize > 1);
-
-    elastic::gpu::Buffer<uint32_t> counterBuffer(engine, counterSize); // 1D index of [workgroupID][key]
-    for (int i = 0; i < counterBuffer.size(); i++)
-      counterBuffer[i] = 0;
-
-    elastic::gpu::DescriptorSetLayout descriptorSetLayout(engine, 3);
-    elastic::gpu::DescriptorSet descriptorSet(engine, descriptorSetLayout, {
-      arrayBuffer,
-      counterBuffer,
-      outBuffer,
-      });
-
-    const std::string shaderDirpath = "C:\\workspace\\elasticize\\src\\elasticize\\shader";
-    elastic::gpu::ComputeShader countShader(engine, shaderDirpath + "\\radix_sort\\count.comp.spv", descriptorSetLayout, {});
-    elastic::gpu::ComputeShader scanForwardShader(engine, shaderDirpath + "\\radix_sort\\scan_forward.comp.spv", descriptorSetLayout, {});
-    elastic::gpu::ComputeShader scanBackwardShader(engine, shaderDirpath + "\\radix_sort\\scan_backward.comp.spv", descriptorSetLayout, {});
-    elastic::gpu::ComputeShader distributeShader(engine, shaderDirpath + "\\radix_sort\\distribute.comp.spv", descriptorSetLayout, {});
+      return lhs.key < rhs.key;
+    };
 
-    // Move to GPU
-    elastic::gpu::Execution(engine).toGpu(arrayBuffer).run();
+    std::mt19937 gen(1234);
 
-    // Radix sort
-    elastic::gpu::Execution execution(engine);
-    struct SortInfoUbo
+    // Scan block size and small sort thresholds of gpu_radix_sort tuned on the first run of this device,
+    // then read back from the tuning cache
+    elastic::gpu::Tuner::Options tunerOptions;
+    tunerOptions.measured = [](const std::string& name, const elastic::gpu::Tuner::Variant& variant, double seconds)
     {
-      uint32_t array_size;
-      int32_t bit_offset;
-      uint32_t scan_offset;
+      std::cout << "Tuning " << name << " [";
+      for (size_t i = 0; i < variant.size(); i++)
+        std::cout << (i > 0 ? "," : "") << variant[i];
+      std::cout << "]: " << seconds * 1e3 << " ms" << std::endl;
     };
-    SortInfoUbo sortInfo;
+    elastic::gpu::Tuner tuner(engine, tunerOptions);
+    {
+      constexpr uint32_t tuningN = 1u << 22;
+      const auto keys = generateKeys("uniform", tuningN, gen);
+      for (uint32_t i = 0; i < tuningN; i++)
+        arrayBuffer[i] = { keys[i], i };
+
+      gpuSorts.front().radixSort.tune(tuner, arrayBuffer, tuningN, keyBits);
+    }
+    std::cout << "Scan block size: " << gpuSorts.front().radixSort.scanBlockSize() << std::endl;
 
-    for (int bitOffset = 0; bitOffset < keyBits; bitOffset += RADIX_BITS)
+    for (const auto n64 : elastic::bench::Benchmark::powersOfTwo(minExponent, maxExponent))
     {
-      sortInfo = { n, bitOffset, 0 };
-      execution
-        .runComputeShader(countShader, descriptorSet, (n + BLOCK_SIZE - 1) / BLOCK_SIZE, sortInfo)
-        .barrier();
+      const auto n = static_cast<uint32_t>(n64);
 
-      // Scan forward
-      struct Phase
-      {
-        uint32_t simdSize;
-        uint32_t scanOffset;
-      };
-      std::vector<Phase> phases;
-      uint32_t scanOffset = 0;
-      simdSize = alignedSize;
-      do
+      for (const auto& distribution : distributions)
       {
-        phases.push_back(Phase{ simdSize, scanOffset });
-        sortInfo = { simdSize, bitOffset, scanOffset };
-        execution
-          .runComputeShader(scanForwardShader, descriptorSet, (simdSize + BLOCK_SIZE - 1) / BLOCK_SIZE, sortInfo)
-          .barrier();
-        scanOffset += simdSize;
-        simdSize = (simdSize + BLOCK_SIZE - 1) / BLOCK_SIZE;
-      } while (simdSize > 1);
-
-      // Scan backward
-      for (int i = static_cast<int>(phases.size()) - 1; i >= 0; i--)
-      {
-        const auto& phase = phases[i];
-        sortInfo = { phase.simdSize, bitOffset, phase.scanOffset };
-        execution
-          .runComputeShader(scanBackwardShader, descriptorSet, (phase.simdSize + BLOCK_SIZE - 1) / BLOCK_SIZE, sortInfo)
-          .barrier();
-      }
+        const auto keys = generateKeys(distribution, n, gen);
 
-      // Now prefix sum of counter[key][block_index], meaning start offset of each group
-      sortInfo = { n, bitOffset, 0 };
-      execution
-        .runComputeShader(distributeShader, descriptorSet, (n + BLOCK_SIZE - 1) / BLOCK_SIZE, sortInfo)
-        .barrier();
+        std::vector<KeyValue> input(n);
+        for (uint32_t i = 0; i < n; i++)
+          input[i] = { keys[i], i };
 
-      // Copy to input buffer
-      execution
-        .copy(outBuffer, arrayBuffer)
-        .barrier();
-    }
-    execution.end();
+        const elastic::bench::Parameters parameters = {
+          { "n", std::to_string(n) },
+          { "distribution", distribution },
+        };
+        const elastic::bench::Throughput throughput{ static_cast<double>(n), "keys", 2. * sizeof(KeyValue) * n };
 
-    std::cout << "GPU radix sort" << std::endl;
-    elastic::utils::Timer gpuTimer;
-    execution.run();
-    std::cout << "Elapsed: " << gpuTimer.elapsed() << std::endl;
+        // Multithreaded CPU baselines, sorting a fresh copy of the input every repetition
+        std::vector<KeyValue> sorted;
+        benchmark.runTimed("cpu_std_sort_par", parameters, throughput, [&]()
+          {
+            sorted = input;
 
-    // From GPU
-    elastic::gpu::Execution(engine).fromGpu(arrayBuffer).run();
+            elastic::utils::Timer timer;
+            std::sort(std::execution::par, sorted.begin(), sorted.end(), byKey);
+            return timer.elapsed();
+          });
 
-    // CPU radix sort
-    std::cout << "CPU radix sort" << std::endl;
-    elastic::utils::Timer cpuRadixSortTimer;
-    std::sort(std::execution::par,
-      buffer.begin(), buffer.end(), [RADIX_SIZE](const KeyValue& lhs, const KeyValue& rhs)
-      {
-        return lhs.key < rhs.key;
-      });
-    std::cout << "Elapsed: " << cpuRadixSortTimer.elapsed() << std::endl;
+        benchmark.runTimed("cpu_std_stable_sort_par", parameters, throughput, [&]()
+          {
+            sorted = input;
+
+            elastic::utils::Timer timer;
+            std::stable_sort(std::execution::par, sorted.begin(), sorted.end(), byKey);
+            return timer.elapsed();
+          });
+
+        for (auto& gpuSort : gpuSorts)
+        {
+          // Timing submit to fence of the sort alone; input is uploaded fresh for every repetition
+          std::copy(input.begin(), input.end(), arrayBuffer.data());
+          benchmark.runTimed(gpuSort.name, parameters, throughput, [&]()
+            {
+              elastic::gpu::Execution(engine).toGpu(arrayBuffer, n).run();
+
+              elastic::gpu::Execution execution(engine);
+              gpuSort.radixSort.sort(execution, arrayBuffer, n, keyBits);
+              execution.end();
+
+              elastic::utils::Timer timer;
+              execution.run();
+              return timer.elapsed();
+            });
+
+          // Sorted and a permutation of the input, checked on the GPU with a few bytes of readback
+          {
+            elastic::gpu::Execution execution(engine);
+            execution.toGpu(arrayBuffer, n).barrier();
+            validator.begin(execution).checksum(execution, arrayBuffer, n, 0);
+            gpuSort.radixSort.sort(execution, arrayBuffer, n, keyBits);
+            validator
+              .isSorted(execution, arrayBuffer, n)
+              .checksum(execution, arrayBuffer, n, 1)
+              .end(execution);
+            execution.end();
+            execution.run();
+
+            const auto& result = validator.result();
+            if (!result.sorted() || !result.permutation())
+              std::cout << "  Validation failed: " << result.unsorted << " unsorted, permutation " << std::boolalpha << result.permutation() << std::noboolalpha << std::endl;
+          }
+
+          // Full comparison against the stable sort, which LSD radix sort matches, also checks stability
+          if (fullValidation)
+          {
+            elastic::gpu::Execution(engine).fromGpu(arrayBuffer, n).run();
+
+            uint32_t mismatches = 0;
+            for (uint32_t i = 0; i < n; i++)
+            {
+              if (sorted[i].key != arrayBuffer[i].key || sorted[i].value != arrayBuffer[i].value)
+                mismatches++;
+            }
+            if (mismatches > 0)
+              std::cout << "  Full validation failed: " << mismatches << " mismatches" << std::endl;
+          }
+        }
+      }
+    }
 
-    // Validate
-    std::cout << "Validating count" << std::endl;
-    for (int i = 0; i < n; i++)
+    // One more profiled and traced run per algorithm for the per-kernel breakdown of the largest uniform input
+    const auto profileKeys = generateKeys("uniform", maxN, gen);
+    for (auto& gpuSort : gpuSorts)
     {
-      if (buffer[i].key != arrayBuffer[i].key)
-        std::cout << "Buffer mismatch at " << std::setw(8) << i << ": value " << std::hex << std::setw(8) << arrayBuffer[i].key << " (expected: " << std::setw(8) << buffer[i].key << std::dec << ")" << std::endl;
+      const auto n = maxN;
+      for (uint32_t i = 0; i < n; i++)
+        arrayBuffer[i] = { profileKeys[i], i };
+
+      elastic::gpu::Execution::Options executionOptions;
+      executionOptions.profile = true;
+      executionOptions.pipelineStatistics = engine.pipelineStatisticsSupported();
+
+      elastic::gpu::Execution(engine).toGpu(arrayBuffer, n).run();
+      engine.resetCounters();
+
+      elastic::gpu::Execution execution(engine, executionOptions);
+      gpuSort.radixSort.sort(execution, arrayBuffer, n, keyBits);
+      execution.end();
+
+      // e.g. bench_radix_sort_trace.json for gpu_radix_sort
+      elastic::utils::Tracer::global().clear();
+      elastic::utils::Tracer::global().enable();
+      execution.run();
+      elastic::utils::Tracer::global().enable(false);
+      elastic::utils::Tracer::global().save("bench_" + gpuSort.name.substr(4) + "_trace.json");
+
+      const auto counters = engine.resetCounters();
+      std::cout << gpuSort.name << " engine activity, n=" << n << std::endl
+        << "  submits     : " << counters.submits << std::endl
+        << "  dispatches  : " << counters.dispatches << std::endl
+        << "  barriers    : " << counters.barriers << std::endl
+        << "  bytes copied: " << counters.bytesCopied << std::endl
+        << "  fence wait  : " << counters.fenceWaitNanoseconds * 1e-6 << " ms" << std::endl;
+
+      // GPU time and compute invocations per kernel, summed over passes
+      struct KernelReport
+      {
+        std::string name;
+        double elapsed = 0.;
+        uint64_t invocations = 0;
+      };
+      std::vector<KernelReport> kernelReports;
+      std::cout << gpuSort.name << " per kernel, n=" << n << std::endl;
+      for (const auto& command : execution.report())
+      {
+        auto it = std::find_if(kernelReports.begin(), kernelReports.end(), [&command](const auto& kernelReport) { return kernelReport.name == command.name; });
+        if (it == kernelReports.end())
+          it = kernelReports.insert(kernelReports.end(), KernelReport{ command.name });
+        it->elapsed += command.elapsed;
+        it->invocations += command.statistics.computeShaderInvocations;
+      }
+      for (const auto& kernelReport : kernelReports)
+      {
+        std::cout << "  " << std::setw(18) << std::left << kernelReport.name << std::right << ": " << kernelReport.elapsed << " ms";
+        if (executionOptions.pipelineStatistics)
+          std::cout << ", " << kernelReport.invocations << " invocations (" << static_cast<double>(kernelReport.invocations) / n << " per element)";
+        std::cout << std::endl;
+      }
     }
-    std::cout << "Validation done" << std::endl;
 
-    std::cout << "First two block:" << std::endl;
-    for (int i = 0; i < BLOCK_SIZE * 2; i++)
-      std::cout << std::setw(4) << i << ' ' << std::setw(4) << arrayBuffer[i].key << ' ' << std::setw(4) << arrayBuffer[i].value << std::endl;
+    benchmark.save();
   }
   catch (const std::exception& e)
   {
@@ -0,0 +1,227 @@
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include <execution>
+#include <numeric>
+#include <algorithm>
+#include <cstring>
+
+#include <elasticize/gpu/engine.h>
+#include <elasticize/gpu/buffer.h>
+#include <elasticize/gpu/execution.h>
+#include <elasticize/gpu/scan.h>
+#include <elasticize/gpu/validator.h>
+#include <elasticize/utils/timer.h>
+#include <elasticize/bench/benchmark.h>
+
+int main(int argc, char** argv)
+{
+  try
+  {
+    constexpr uint32_t minExponent = 10;
+    constexpr uint32_t maxExponent = 26;
+    constexpr uint32_t maxN = 1u << maxExponent;
+
+    using elastic::gpu::Scan;
+
+    Scan::Options multiLevelOptions;
+    multiLevelOptions.maxCount = maxN;
+    multiLevelOptions.algorithm = Scan::Algorithm::MultiLevel;
+
+    Scan::Options lookBackOptions;
+    lookBackOptions.maxCount = maxN;
+    lookBackOptions.algorithm = Scan::Algorithm::DecoupledLookBack;
+
+    // Buffers are allocated once for the largest size, the pool does not reclaim memory
+    elastic::gpu::Engine::Options options;
+    options.headless = true;
+    options.memoryPoolSize = (2 * sizeof(uint32_t) + 2 * sizeof(int32_t) + 2 * sizeof(float)) * maxN +
+      Scan::scratchSize(multiLevelOptions) + Scan::scratchSize(lookBackOptions) + 64ull * 1024 * 1024;
+    elastic::gpu::Engine engine(elastic::bench::Benchmark::engineOptions(options));
+
+    elastic::bench::Benchmark benchmark("scan", elastic::bench::Benchmark::parseArguments(argc, argv));
+
+    // Reads every scanned array back and compares it on the CPU, on top of the GPU validation of the uint sum
+    const auto fullValidation = std::any_of(argv + 1, argv + argc, [](const char* argument) { return std::strcmp(argument, "--full-validation") == 0; });
+
+    std::cout << "Engine started!" << std::endl;
+
+    elastic::gpu::Buffer<uint32_t> inputBuffer(engine, maxN);
+    elastic::gpu::Buffer<uint32_t> outputBuffer(engine, maxN);
+    elastic::gpu::Buffer<int32_t> intInputBuffer(engine, maxN);
+    elastic::gpu::Buffer<int32_t> intOutputBuffer(engine, maxN);
+    elastic::gpu::Buffer<float> floatInputBuffer(engine, maxN);
+    elastic::gpu::Buffer<float> floatOutputBuffer(engine, maxN);
+    inputBuffer.setName("scan_input");
+    outputBuffer.setName("scan_output");
+    intInputBuffer.setName("scan_int_input");
+    intOutputBuffer.setName("scan_int_output");
+    floatInputBuffer.setName("scan_float_input");
+    floatOutputBuffer.setName("scan_float_output");
+
+    const std::string shaderDirpath = "C:\\workspace\\elasticize\\src\\elasticize\\shader";
+
+    // Benchmark case name and scan of each algorithm
+    struct GpuScan
+    {
+      std::string name;
+      Scan scan;
+    };
+    std::vector<GpuScan> gpuScans;
+    gpuScans.push_back({ "multi_level", Scan(engine, shaderDirpath, multiLevelOptions) });
+    gpuScans.push_back({ "look_back", Scan(engine, shaderDirpath, lookBackOptions) });
+
+    elastic::gpu::Validator validator(engine, shaderDirpath);
+
+    // Reads the first n outputs back and counts those differing from the CPU scan
+    const auto validateFull = [&engine](auto& outputBuffer, const auto& expected, uint32_t n)
+    {
+      elastic::gpu::Execution(engine).fromGpu(outputBuffer, n).run();
+
+      uint32_t mismatches = 0;
+      for (uint32_t i = 0; i < n; i++)
+      {
+        if (outputBuffer[i] != expected[i])
+          mismatches++;
+      }
+      if (mismatches > 0)
+        std::cout << "  Full validation failed: " << mismatches << " mismatches" << std::endl;
+    };
+
+    std::mt19937 gen(1234);
+    for (const auto n64 : elastic::bench::Benchmark::powersOfTwo(minExponent, maxExponent))
+    {
+      const auto n = static_cast<uint32_t>(n64);
+
+      // Small counts like the output slots of a compaction, signed deltas, and distances for a running max
+      std::uniform_int_distribution<uint32_t> counts(0, 16);
+      std::uniform_int_distribution<int32_t> deltas(-16, 16);
+      std::uniform_real_distribution<float> distances(0.f, 100.f);
+      std::vector<uint32_t> input(n);
+      std::vector<int32_t> intInput(n);
+      std::vector<float> floatInput(n);
+      for (uint32_t i = 0; i < n; i++)
+      {
+        input[i] = counts(gen);
+        intInput[i] = deltas(gen);
+        floatInput[i] = distances(gen);
+      }
+      std::copy(input.begin(), input.end(), inputBuffer.data());
+      std::copy(intInput.begin(), intInput.end(), intInputBuffer.data());
+      std::copy(floatInput.begin(), floatInput.end(), floatInputBuffer.data());
+
+      const elastic::bench::Parameters parameters = {
+        { "n", std::to_string(n) },
+      };
+      const elastic::bench::Throughput throughput{ static_cast<double>(n), "values", 2. * sizeof(uint32_t) * n };
+
+      std::vector<uint32_t> scanned(n);
+      benchmark.run("cpu_exclusive_scan_par", parameters, throughput, [&]()
+        {
+          std::exclusive_scan(std::execution::par, input.begin(), input.end(), scanned.begin(), 0u);
+        });
+
+      std::vector<int32_t> intScanned(n);
+      benchmark.run("cpu_exclusive_sum_i32_par", parameters, throughput, [&]()
+        {
+          std::exclusive_scan(std::execution::par, intInput.begin(), intInput.end(), intScanned.begin(), 0);
+        });
+
+      std::vector<int32_t> minScanned(n);
+      benchmark.run("cpu_inclusive_min_i32_par", parameters, throughput, [&]()
+        {
+          std::inclusive_scan(std::execution::par, intInput.begin(), intInput.end(), minScanned.begin(), [](int32_t lhs, int32_t rhs) { return std::min(lhs, rhs); });
+        });
+
+      std::vector<float> maxScanned(n);
+      benchmark.run("cpu_inclusive_max_par", parameters, throughput, [&]()
+        {
+          std::inclusive_scan(std::execution::par, floatInput.begin(), floatInput.end(), maxScanned.begin(), [](float lhs, float rhs) { return std::max(lhs, rhs); });
+        });
+
+      elastic::gpu::Execution(engine).toGpu(inputBuffer, n).toGpu(intInputBuffer, n).toGpu(floatInputBuffer, n).run();
+
+      for (auto& gpuScan : gpuScans)
+      {
+        // Timing submit to fence of the scan alone, the input stays on the GPU
+        benchmark.runTimed("gpu_exclusive_sum_" + gpuScan.name, parameters, throughput, [&]()
+          {
+            elastic::gpu::Execution execution(engine);
+            gpuScan.scan.exclusive(execution, inputBuffer, outputBuffer, n);
+            execution.end();
+
+            elastic::utils::Timer timer;
+            execution.run();
+            return timer.elapsed();
+          });
+
+        {
+          elastic::gpu::Execution execution(engine);
+          validator.begin(execution).scan(execution, inputBuffer, outputBuffer, n).end(execution);
+          execution.end();
+          execution.run();
+
+          const auto& result = validator.result();
+          if (!result.scanConsistent())
+            std::cout << "  Validation failed: " << result.scanMismatches << " mismatches, first at " << result.firstScanMismatch << std::endl;
+        }
+
+        if (fullValidation)
+          validateFull(outputBuffer, scanned, n);
+
+        benchmark.runTimed("gpu_exclusive_sum_i32_" + gpuScan.name, parameters, throughput, [&]()
+          {
+            elastic::gpu::Execution execution(engine);
+            gpuScan.scan.exclusive(execution, intInputBuffer, intOutputBuffer, n);
+            execution.end();
+
+            elastic::utils::Timer timer;
+            execution.run();
+            return timer.elapsed();
+          });
+
+        if (fullValidation)
+          validateFull(intOutputBuffer, intScanned, n);
+
+        benchmark.runTimed("gpu_inclusive_min_i32_" + gpuScan.name, parameters, throughput, [&]()
+          {
+            elastic::gpu::Execution execution(engine);
+            gpuScan.scan.inclusive(execution, intInputBuffer, intOutputBuffer, n, Scan::Operator::Min);
+            execution.end();
+
+            elastic::utils::Timer timer;
+            execution.run();
+            return timer.elapsed();
+          });
+
+        if (fullValidation)
+          validateFull(intOutputBuffer, minScanned, n);
+
+        benchmark.runTimed("gpu_inclusive_max_f32_" + gpuScan.name, parameters, throughput, [&]()
+          {
+            elastic::gpu::Execution execution(engine);
+            gpuScan.scan.inclusive(execution, floatInputBuffer, floatOutputBuffer, n, Scan::Operator::Max);
+            execution.end();
+
+            elastic::utils::Timer timer;
+            execution.run();
+            return timer.elapsed();
+          });
+
+        // Max is exact for floats
+        if (fullValidation)
+          validateFull(floatOutputBuffer, maxScanned, n);
+      }
+    }
+
+    benchmark.save();
+  }
+  catch (const std::exception& e)
+  {
+    std::cerr << e.what() << std::endl;
+    return 1;
+  }
+
+  return 0;
+}
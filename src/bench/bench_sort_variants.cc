@@ -0,0 +1,376 @@
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include <execution>
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+#include <elasticize/gpu/engine.h>
+#include <elasticize/gpu/buffer.h>
+#include <elasticize/gpu/execution.h>
+#include <elasticize/gpu/radix_sort.h>
+#include <elasticize/gpu/segmented_sort.h>
+#include <elasticize/gpu/validator.h>
+#include <elasticize/utils/timer.h>
+#include <elasticize/bench/benchmark.h>
+
+namespace
+{
+// Key type shown in case names and checked by the validator
+template <typename Key>
+struct KeyTraits;
+
+template <>
+struct KeyTraits<uint32_t>
+{
+  static constexpr auto name = "u32";
+  static constexpr auto keyType = elastic::gpu::Validator::KeyType::Uint;
+};
+
+template <>
+struct KeyTraits<int32_t>
+{
+  static constexpr auto name = "i32";
+  static constexpr auto keyType = elastic::gpu::Validator::KeyType::Int;
+};
+
+template <>
+struct KeyTraits<float>
+{
+  static constexpr auto name = "f32";
+  static constexpr auto keyType = elastic::gpu::Validator::KeyType::Float;
+};
+
+template <>
+struct KeyTraits<uint64_t>
+{
+  static constexpr auto name = "u64";
+  static constexpr auto keyType = elastic::gpu::Validator::KeyType::Uint64;
+};
+
+// Full 32-bit codes, signed offsets of both signs, depths and distances of both signs, and 64-bit Morton codes
+std::vector<uint32_t> generateKeys(uint32_t n, std::mt19937& gen, uint32_t)
+{
+  std::uniform_int_distribution<uint32_t> uniform;
+  std::vector<uint32_t> keys(n);
+  for (auto& key : keys)
+    key = uniform(gen);
+  return keys;
+}
+
+std::vector<int32_t> generateKeys(uint32_t n, std::mt19937& gen, int32_t)
+{
+  std::uniform_int_distribution<int32_t> uniform(std::numeric_limits<int32_t>::min(), std::numeric_limits<int32_t>::max());
+  std::vector<int32_t> keys(n);
+  for (auto& key : keys)
+    key = uniform(gen);
+  return keys;
+}
+
+std::vector<float> generateKeys(uint32_t n, std::mt19937& gen, float)
+{
+  std::normal_distribution<float> depth(0.f, 100.f);
+  std::vector<float> keys(n);
+  for (auto& key : keys)
+    key = depth(gen);
+  return keys;
+}
+
+std::vector<uint64_t> generateKeys(uint32_t n, std::mt19937& gen, uint64_t)
+{
+  std::uniform_int_distribution<uint64_t> uniform(0, (1ull << 63) - 1);
+  std::vector<uint64_t> keys(n);
+  for (auto& key : keys)
+    key = uniform(gen);
+  return keys;
+}
+
+struct Context
+{
+  elastic::gpu::Engine engine;
+  elastic::bench::Benchmark& benchmark;
+  elastic::gpu::RadixSort& radixSort;
+  elastic::gpu::Validator& validator;
+  elastic::gpu::Buffer<uint32_t>& permutationBuffer;
+  bool fullValidation;
+};
+
+// Keys-only and permutation sorts of one key type against a multithreaded CPU sort of the same data
+template <typename Key>
+void benchKeys(Context& context, elastic::gpu::Buffer<Key>& keyBuffer, uint32_t n, std::mt19937& gen)
+{
+  const auto input = generateKeys(n, gen, Key());
+  const std::string suffix = KeyTraits<Key>::name;
+
+  const elastic::bench::Parameters parameters = {
+    { "n", std::to_string(n) },
+  };
+  const elastic::bench::Throughput keysThroughput{ static_cast<double>(n), "keys", 2. * sizeof(Key) * n };
+  const elastic::bench::Throughput permutationThroughput{ static_cast<double>(n), "keys", 2. * (sizeof(Key) + sizeof(uint32_t)) * n };
+
+  std::vector<Key> sorted;
+  context.benchmark.runTimed("cpu_sort_keys_" + suffix, parameters, keysThroughput, [&]()
+    {
+      sorted = input;
+
+      elastic::utils::Timer timer;
+      std::sort(std::execution::par, sorted.begin(), sorted.end());
+      return timer.elapsed();
+    });
+
+  // Same timing as bench_radix_sort: submit to fence of the sort alone, input uploaded fresh for every repetition
+  const auto runSort = [&](const std::string& name, const elastic::bench::Throughput& throughput, bool permutation)
+  {
+    const auto record = [&](elastic::gpu::Execution& execution)
+    {
+      if (permutation)
+        context.radixSort.sortPermutation(execution, keyBuffer, context.permutationBuffer, n);
+      else
+        context.radixSort.sortKeys(execution, keyBuffer, n);
+    };
+
+    std::copy(input.begin(), input.end(), keyBuffer.data());
+    context.benchmark.runTimed(name, parameters, throughput, [&]()
+      {
+        elastic::gpu::Execution(context.engine).toGpu(keyBuffer, n).run();
+
+        elastic::gpu::Execution execution(context.engine);
+        record(execution);
+        execution.end();
+
+        elastic::utils::Timer timer;
+        execution.run();
+        return timer.elapsed();
+      });
+
+    // Sorted and a permutation of the input keys, checked on the GPU
+    {
+      elastic::gpu::Execution execution(context.engine);
+      execution.toGpu(keyBuffer, n).barrier();
+      context.validator.begin(execution).checksum(execution, keyBuffer, n, 0);
+      record(execution);
+      context.validator
+        .isSorted(execution, keyBuffer, n, KeyTraits<Key>::keyType)
+        .checksum(execution, keyBuffer, n, 1)
+        .end(execution);
+      execution.end();
+      execution.run();
+
+      const auto& result = context.validator.result();
+      if (!result.sorted() || !result.permutation())
+        std::cout << "  Validation failed: " << result.unsorted << " unsorted, permutation " << std::boolalpha << result.permutation() << std::noboolalpha << std::endl;
+    }
+
+    // Keys against the CPU sort, and every index pointing at its key in the input
+    if (context.fullValidation)
+    {
+      elastic::gpu::Execution execution(context.engine);
+      execution.fromGpu(keyBuffer, n);
+      if (permutation)
+        execution.fromGpu(context.permutationBuffer, n);
+      execution.run();
+
+      uint32_t mismatches = 0;
+      for (uint32_t i = 0; i < n; i++)
+      {
+        if (std::memcmp(&sorted[i], &keyBuffer[i], sizeof(Key)) != 0 ||
+          (permutation && (context.permutationBuffer[i] >= n || std::memcmp(&input[context.permutationBuffer[i]], &keyBuffer[i], sizeof(Key)) != 0)))
+          mismatches++;
+      }
+      if (mismatches > 0)
+        std::cout << "  Full validation failed: " << mismatches << " mismatches" << std::endl;
+    }
+  };
+
+  runSort("gpu_sort_keys_" + suffix, keysThroughput, false);
+  runSort("gpu_sort_permutation_" + suffix, permutationThroughput, true);
+}
+
+// Segment offsets covering n elements: "tiny" segments of 1 to 64 elements like contacts per body,
+// "mixed" adds a few segments of thousands of elements like crowded grid cells
+std::vector<uint32_t> generateOffsets(const std::string& distribution, uint32_t n, std::mt19937& gen)
+{
+  std::uniform_int_distribution<uint32_t> tiny(1, 64);
+  std::uniform_int_distribution<uint32_t> large(4096, 65536);
+  std::bernoulli_distribution crowded(distribution == "mixed" ? 0.001 : 0.);
+
+  std::vector<uint32_t> offsets = { 0 };
+  while (offsets.back() < n)
+    offsets.push_back(std::min(n, offsets.back() + (crowded(gen) ? large(gen) : tiny(gen))));
+  return offsets;
+}
+
+void benchSegmented(Context& context, elastic::gpu::SegmentedSort& segmentedSort, elastic::gpu::Buffer<elastic::gpu::KeyValue>& keyValueBuffer, elastic::gpu::Buffer<uint32_t>& offsetBuffer, uint32_t n, std::mt19937& gen)
+{
+  using elastic::gpu::KeyValue;
+
+  const auto byKey = [](const KeyValue& lhs, const KeyValue& rhs)
+  {
+    return lhs.key < rhs.key;
+  };
+
+  for (const std::string distribution : { "tiny", "mixed" })
+  {
+    const auto offsets = generateOffsets(distribution, n, gen);
+    const auto segmentCount = static_cast<uint32_t>(offsets.size() - 1);
+    std::copy(offsets.begin(), offsets.end(), offsetBuffer.data());
+
+    std::uniform_int_distribution<uint32_t> uniform;
+    std::vector<KeyValue> input(n);
+    for (uint32_t i = 0; i < n; i++)
+      input[i] = { uniform(gen), i };
+
+    const elastic::bench::Parameters parameters = {
+      { "n", std::to_string(n) },
+      { "segments", distribution },
+    };
+    const elastic::bench::Throughput throughput{ static_cast<double>(n), "keys", 2. * sizeof(KeyValue) * n };
+
+    // Segments sorted in parallel
+    std::vector<uint32_t> segments(segmentCount);
+    for (uint32_t i = 0; i < segmentCount; i++)
+      segments[i] = i;
+
+    std::vector<KeyValue> sorted;
+    context.benchmark.runTimed("cpu_segmented_stable_sort_par", parameters, throughput, [&]()
+      {
+        sorted = input;
+
+        elastic::utils::Timer timer;
+        std::for_each(std::execution::par, segments.begin(), segments.end(), [&](uint32_t segment)
+          {
+            std::stable_sort(sorted.begin() + offsets[segment], sorted.begin() + offsets[segment + 1], byKey);
+          });
+        return timer.elapsed();
+      });
+
+    std::copy(input.begin(), input.end(), keyValueBuffer.data());
+    context.benchmark.runTimed("gpu_segmented_sort", parameters, throughput, [&]()
+      {
+        elastic::gpu::Execution(context.engine).toGpu(keyValueBuffer, n).run();
+
+        elastic::gpu::Execution execution(context.engine);
+        segmentedSort.sort(execution, keyValueBuffer, offsetBuffer, segmentCount);
+        execution.end();
+
+        elastic::utils::Timer timer;
+        execution.run();
+        return timer.elapsed();
+      });
+
+    // Sorted within every segment and a permutation of the input, checked on the GPU
+    {
+      elastic::gpu::Execution execution(context.engine);
+      execution.toGpu(keyValueBuffer, n).barrier();
+      context.validator.begin(execution).checksum(execution, keyValueBuffer, n, 0);
+      segmentedSort.sort(execution, keyValueBuffer, offsetBuffer, segmentCount);
+      context.validator
+        .isSegmentSorted(execution, keyValueBuffer, offsetBuffer, segmentCount, n)
+        .checksum(execution, keyValueBuffer, n, 1)
+        .end(execution);
+      execution.end();
+      execution.run();
+
+      const auto& result = context.validator.result();
+      if (!result.sorted() || !result.permutation())
+        std::cout << "  Validation failed: " << result.unsorted << " unsorted, permutation " << std::boolalpha << result.permutation() << std::noboolalpha << std::endl;
+    }
+
+    // Elements against the CPU sort, which also checks stability
+    if (context.fullValidation)
+    {
+      elastic::gpu::Execution(context.engine).fromGpu(keyValueBuffer, n).run();
+
+      uint32_t mismatches = 0;
+      for (uint32_t i = 0; i < n; i++)
+      {
+        if (sorted[i].key != keyValueBuffer[i].key || sorted[i].value != keyValueBuffer[i].value)
+          mismatches++;
+      }
+      if (mismatches > 0)
+        std::cout << "  Full validation failed: " << mismatches << " mismatches" << std::endl;
+    }
+  }
+}
+}
+
+int main(int argc, char** argv)
+{
+  try
+  {
+    constexpr uint32_t minExponent = 12;
+    constexpr uint32_t maxExponent = 24;
+    constexpr uint32_t maxN = 1u << maxExponent;
+
+    using elastic::gpu::RadixSort;
+
+    RadixSort::Options radixSortOptions;
+    radixSortOptions.maxCount = maxN;
+    radixSortOptions.permutation = true;
+
+    elastic::gpu::SegmentedSort::Options segmentedSortOptions;
+    segmentedSortOptions.maxCount = maxN;
+    segmentedSortOptions.maxSegments = maxN;
+
+    // Buffers are allocated once for the largest size, the pool does not reclaim memory
+    elastic::gpu::Engine::Options options;
+    options.headless = true;
+    options.memoryPoolSize = (sizeof(uint32_t) + sizeof(int32_t) + sizeof(float) + sizeof(uint64_t) + sizeof(uint32_t) + sizeof(elastic::gpu::KeyValue) + sizeof(uint32_t)) * maxN +
+      RadixSort::scratchSize(radixSortOptions) + elastic::gpu::SegmentedSort::scratchSize(segmentedSortOptions) + 64ull * 1024 * 1024;
+    elastic::gpu::Engine engine(elastic::bench::Benchmark::engineOptions(options));
+
+    elastic::bench::Benchmark benchmark("sort_variants", elastic::bench::Benchmark::parseArguments(argc, argv));
+
+    // Reads every sorted array back and compares it on the CPU, on top of the GPU validation
+    const auto fullValidation = std::any_of(argv + 1, argv + argc, [](const char* argument) { return std::strcmp(argument, "--full-validation") == 0; });
+
+    std::cout << "Engine started!" << std::endl;
+
+    elastic::gpu::Buffer<uint32_t> uintBuffer(engine, maxN);
+    elastic::gpu::Buffer<int32_t> intBuffer(engine, maxN);
+    elastic::gpu::Buffer<float> floatBuffer(engine, maxN);
+    elastic::gpu::Buffer<uint64_t> uint64Buffer(engine, maxN);
+    elastic::gpu::Buffer<uint32_t> permutationBuffer(engine, maxN);
+    uintBuffer.setName("sort_variants_u32");
+    intBuffer.setName("sort_variants_i32");
+    floatBuffer.setName("sort_variants_f32");
+    uint64Buffer.setName("sort_variants_u64");
+    permutationBuffer.setName("sort_variants_permutation");
+
+    elastic::gpu::Buffer<elastic::gpu::KeyValue> keyValueBuffer(engine, maxN);
+    elastic::gpu::Buffer<uint32_t> offsetBuffer(engine, maxN + 1);
+    keyValueBuffer.setName("sort_variants_key_values");
+    offsetBuffer.setName("sort_variants_offsets");
+
+    const std::string shaderDirpath = "C:\\workspace\\elasticize\\src\\elasticize\\shader";
+
+    RadixSort radixSort(engine, shaderDirpath, radixSortOptions);
+    elastic::gpu::SegmentedSort segmentedSort(engine, shaderDirpath, segmentedSortOptions);
+    elastic::gpu::Validator validator(engine, shaderDirpath);
+
+    Context context{ engine, benchmark, radixSort, validator, permutationBuffer, fullValidation };
+
+    std::mt19937 gen(1234);
+    for (const auto n64 : elastic::bench::Benchmark::powersOfTwo(minExponent, maxExponent))
+    {
+      const auto n = static_cast<uint32_t>(n64);
+
+      benchKeys(context, uintBuffer, n, gen);
+      benchKeys(context, intBuffer, n, gen);
+      benchKeys(context, floatBuffer, n, gen);
+      benchKeys(context, uint64Buffer, n, gen);
+      benchSegmented(context, segmentedSort, keyValueBuffer, offsetBuffer, n, gen);
+    }
+
+    benchmark.save();
+  }
+  catch (const std::exception& e)
+  {
+    std::cerr << e.what() << std::endl;
+    return 1;
+  }
+
+  return 0;
+}
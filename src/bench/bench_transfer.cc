@@ -0,0 +1,259 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cstring>
+#include <algorithm>
+#include <optional>
+
+#include <elasticize/gpu/engine.h>
+#include <elasticize/gpu/buffer.h>
+#include <elasticize/gpu/execution.h>
+#include <elasticize/gpu/gather.h>
+#include <elasticize/gpu/uniform_buffer.h>
+#include <elasticize/gpu/descriptor_set.h>
+#include <elasticize/gpu/descriptor_set_layout.h>
+#include <elasticize/gpu/compute_shader.h>
+#include <elasticize/utils/timer.h>
+#include <elasticize/bench/benchmark.h>
+
+namespace
+{
+// Layout of ObjectUbo in shader/utils/affine.comp
+struct ObjectParameters
+{
+  uint32_t scale;
+  uint32_t bias;
+};
+
+struct AffineInfo
+{
+  uint32_t begin;
+  uint32_t count;
+};
+}
+
+int main(int argc, char** argv)
+{
+  try
+  {
+    constexpr uint32_t minExponent = 12; // 4KB
+    constexpr uint32_t maxExponent = 30; // 1GB
+    constexpr uint64_t maxBytes = 1ull << maxExponent;
+    constexpr uint64_t maxCount = maxBytes / sizeof(uint32_t);
+
+    // Two device buffers for device-to-device copies and gather indices, the staging buffer is as large as the pool
+    elastic::gpu::Engine::Options options;
+    options.headless = true;
+    options.memoryPoolSize = 3 * maxBytes + 64ull * 1024 * 1024;
+    elastic::gpu::Engine engine(elastic::bench::Benchmark::engineOptions(options));
+
+    elastic::bench::Benchmark benchmark("transfer", elastic::bench::Benchmark::parseArguments(argc, argv));
+
+    std::cout << "Engine started!" << std::endl;
+
+    elastic::gpu::Buffer<uint32_t> srcBuffer(engine, maxCount);
+    elastic::gpu::Buffer<uint32_t> dstBuffer(engine, maxCount);
+    elastic::gpu::Buffer<uint32_t> indexBuffer(engine, maxCount);
+    for (uint64_t i = 0; i < maxCount; i++)
+      srcBuffer[i] = static_cast<uint32_t>(i);
+
+    const std::string shaderDirpath = "C:\\workspace\\elasticize\\src\\elasticize\\shader";
+
+    std::optional<elastic::gpu::Gather> gather;
+    if (elastic::gpu::Gather::supported(engine))
+      gather.emplace(engine, shaderDirpath);
+    else
+      std::cout << "Buffer device address not supported on this device" << std::endl;
+
+    // Per-object parameters of a few hundred objects in one dynamic uniform buffer, bound through a single descriptor set
+    constexpr uint32_t objectCount = 256;
+    elastic::gpu::UniformBuffer<ObjectParameters> objectBuffer(engine, objectCount);
+    for (uint32_t i = 0; i < objectCount; i++)
+      objectBuffer[objectBuffer.allocate()] = { 2 * i + 1, i };
+
+    elastic::gpu::DescriptorSetLayout objectLayout(engine, { vk::DescriptorType::eUniformBufferDynamic, vk::DescriptorType::eStorageBuffer });
+    elastic::gpu::ComputeShader affineShader(engine, elastic::gpu::ComputeShader::CreateInfo{ shaderDirpath + "\\utils\\affine.comp.spv", objectLayout, {} });
+    elastic::gpu::DescriptorSet objectSet(engine, objectLayout, { objectBuffer, dstBuffer });
+    elastic::gpu::Execution(engine).toGpu(objectBuffer).end().run();
+
+    elastic::gpu::Execution::Options profileOptions;
+    profileOptions.profile = true;
+
+    // GPU time of the single command in a profiled execution, in seconds
+    const auto gpuElapsed = [](const elastic::gpu::Execution& execution)
+    {
+      return execution.report().front().elapsed * 1e-3;
+    };
+
+    // Submit and fence round trip with nothing to do, the floor of every transfer below
+    const auto submitLatency = benchmark.run("empty_submit", {}, {}, [&]()
+      {
+        elastic::gpu::Execution execution(engine);
+        execution.end();
+        execution.run();
+      }).median;
+
+    for (const auto bytes : elastic::bench::Benchmark::powersOfTwo(minExponent, maxExponent))
+    {
+      const auto count = bytes / sizeof(uint32_t);
+      const elastic::bench::Parameters parameters = {
+        { "bytes", std::to_string(bytes) },
+      };
+      const elastic::bench::Throughput throughput{ 0., "items", static_cast<double>(bytes) };
+
+      // Host reference: plain memcpy between pageable allocations
+      benchmark.run("host_memcpy", parameters, throughput, [&]()
+        {
+          std::memcpy(dstBuffer.data(), srcBuffer.data(), bytes);
+        });
+
+      // toGpu copies into the mapped staging buffer while recording
+      benchmark.runTimed("staging_memcpy_in", parameters, throughput, [&]()
+        {
+          elastic::gpu::Execution execution(engine);
+
+          elastic::utils::Timer timer;
+          execution.toGpu(srcBuffer, count);
+          const auto elapsed = timer.elapsed();
+
+          execution.end();
+          execution.run();
+          return elapsed;
+        });
+
+      // Upload end to end: staging memcpy, submit, copy over the bus, fence
+      benchmark.run("upload", parameters, throughput, [&]()
+        {
+          elastic::gpu::Execution(engine).toGpu(srcBuffer, count).end().run();
+        });
+
+      benchmark.runTimed("upload_gpu", parameters, throughput, [&]()
+        {
+          elastic::gpu::Execution execution(engine, profileOptions);
+          execution.toGpu(srcBuffer, count).end().run();
+          return gpuElapsed(execution);
+        });
+
+      // Readback end to end: submit, copy over the bus, fence, staging memcpy
+      benchmark.run("readback", parameters, throughput, [&]()
+        {
+          elastic::gpu::Execution(engine).fromGpu(dstBuffer, count).end().run();
+        });
+
+      benchmark.runTimed("readback_gpu", parameters, throughput, [&]()
+        {
+          elastic::gpu::Execution execution(engine, profileOptions);
+          execution.fromGpu(dstBuffer, count).end().run();
+          return gpuElapsed(execution);
+        });
+
+      // fromGpu copies out of the staging buffer inside run(), after the fence; isolated by
+      // removing the GPU copy and the empty submit round trip from the run() time
+      benchmark.runTimed("staging_memcpy_out", parameters, throughput, [&]()
+        {
+          elastic::gpu::Execution execution(engine, profileOptions);
+          execution.fromGpu(dstBuffer, count).end();
+
+          elastic::utils::Timer timer;
+          execution.run();
+          const auto elapsed = timer.elapsed();
+
+          return std::max(0., elapsed - gpuElapsed(execution) - submitLatency);
+        });
+
+      // Device to device, read and write both count against bandwidth
+      const elastic::bench::Throughput copyThroughput{ 0., "items", 2. * bytes };
+      benchmark.runTimed("device_copy_gpu", parameters, copyThroughput, [&]()
+        {
+          elastic::gpu::Execution execution(engine, profileOptions);
+          execution.copy(srcBuffer, dstBuffer, count).end().run();
+          return gpuElapsed(execution);
+        });
+
+      // Gather through buffer device addresses with no descriptor set, reading indices and values and writing values
+      if (gather)
+      {
+        // An odd multiplier modulo a power of two permutes the indices, scattering the reads
+        for (uint64_t i = 0; i < count; i++)
+          indexBuffer[i] = static_cast<uint32_t>((i * 2654435761ull) & (count - 1));
+        elastic::gpu::Execution(engine).toGpu(indexBuffer, count).toGpu(srcBuffer, count).end().run();
+
+        const elastic::bench::Throughput gatherThroughput{ static_cast<double>(count), "items", 3. * bytes };
+        benchmark.runTimed("gather_gpu", parameters, gatherThroughput, [&]()
+          {
+            elastic::gpu::Execution execution(engine, profileOptions);
+            gather->gather(execution, srcBuffer, indexBuffer, dstBuffer, static_cast<uint32_t>(count));
+            execution.end();
+            execution.run();
+            return gpuElapsed(execution);
+          });
+
+        // Source values are their own indices, so every output is its gather index
+        elastic::gpu::Execution(engine).fromGpu(dstBuffer, count).end().run();
+
+        uint64_t mismatches = 0;
+        for (uint64_t i = 0; i < count; i++)
+        {
+          if (dstBuffer[i] != indexBuffer[i])
+            mismatches++;
+        }
+        if (mismatches > 0)
+          std::cout << "  Gather validation failed: " << mismatches << " mismatches" << std::endl;
+      }
+
+      // One dispatch per object over an equal share of the values, each selecting its parameters by dynamic offset
+      {
+        const auto objectSize = static_cast<uint32_t>(count / objectCount);
+        const auto recordObjects = [&](elastic::gpu::Execution& execution)
+        {
+          for (uint32_t i = 0; i < objectCount; i++)
+          {
+            const AffineInfo affineInfo{ i * objectSize, objectSize };
+            execution.runComputeShader(affineShader, objectSet, { objectBuffer.offset(i) }, (objectSize + 255) / 256, affineInfo);
+          }
+          execution.barrier();
+        };
+
+        const elastic::bench::Throughput objectThroughput{ static_cast<double>(count), "items", 2. * bytes };
+        benchmark.runTimed("uniform_objects_gpu", parameters, objectThroughput, [&]()
+          {
+            elastic::gpu::Execution execution(engine, profileOptions);
+            recordObjects(execution);
+            execution.end();
+            execution.run();
+
+            double elapsed = 0.;
+            for (const auto& command : execution.report())
+              elapsed += command.elapsed * 1e-3;
+            return elapsed;
+          });
+
+        // A single pass over values equal to their indices, checked against the CPU
+        elastic::gpu::Execution execution(engine);
+        execution.copy(srcBuffer, dstBuffer, count).barrier();
+        recordObjects(execution);
+        execution.fromGpu(dstBuffer, count).end();
+        execution.run();
+
+        uint64_t mismatches = 0;
+        for (uint64_t i = 0; i < count; i++)
+        {
+          const auto& object = objectBuffer[static_cast<uint32_t>(i / objectSize)];
+          if (dstBuffer[i] != object.scale * static_cast<uint32_t>(i) + object.bias)
+            mismatches++;
+        }
+        if (mismatches > 0)
+          std::cout << "  Uniform object validation failed: " << mismatches << " mismatches" << std::endl;
+      }
+    }
+
+    benchmark.save();
+  }
+  catch (const std::exception& e)
+  {
+    std::cerr << e.what() << std::endl;
+    return 1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,306 @@
+#include <elasticize/bench/benchmark.h>
+
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <algorithm>
+#include <numeric>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+#include <elasticize/utils/timer.h>
+
+namespace elastic
+{
+namespace bench
+{
+namespace
+{
+std::string escapeJson(const std::string& s)
+{
+  std::string result;
+  for (auto c : s)
+  {
+    if (c == '"' || c == '\\')
+      result += '\\';
+    result += c;
+  }
+  return result;
+}
+
+std::string escapeCsv(const std::string& s)
+{
+  if (s.find_first_of(",\"\n") == std::string::npos)
+    return s;
+
+  std::string result = "\"";
+  for (auto c : s)
+  {
+    if (c == '"')
+      result += '"';
+    result += c;
+  }
+  return result + "\"";
+}
+
+// Nearest-rank percentile of sorted samples
+double percentile(const std::vector<double>& sorted, double p)
+{
+  const auto rank = static_cast<size_t>(std::ceil(p * sorted.size()));
+  return sorted[std::min(sorted.size(), std::max<size_t>(rank, 1)) - 1];
+}
+}
+
+class Benchmark::Impl
+{
+public:
+  Impl() = delete;
+
+  Impl(const std::string& name, const Options& options)
+    : name_(name)
+    , options_(options)
+  {
+    if (options_.repetitions == 0)
+      throw std::runtime_error("Benchmark needs at least one repetition");
+
+    std::cout << "Benchmark " << name_ << ": "
+      << options_.warmup << " warmup, " << options_.repetitions << " repetitions" << std::endl;
+  }
+
+  ~Impl() = default;
+
+  Result run(const std::string& name, const Parameters& parameters, const Throughput& throughput, std::function<double()> function)
+  {
+    for (uint32_t i = 0; i < options_.warmup; i++)
+      function();
+
+    Result result;
+    result.name = name;
+    result.parameters = parameters;
+    result.throughput = throughput;
+    for (uint32_t i = 0; i < options_.repetitions; i++)
+      result.samples.push_back(function());
+
+    auto sorted = result.samples;
+    std::sort(sorted.begin(), sorted.end());
+    result.min = sorted.front();
+    result.median = sorted.size() % 2 == 1
+      ? sorted[sorted.size() / 2]
+      : (sorted[sorted.size() / 2 - 1] + sorted[sorted.size() / 2]) / 2.;
+    result.p95 = percentile(sorted, 0.95);
+    result.mean = std::accumulate(sorted.begin(), sorted.end(), 0.) / sorted.size();
+
+    if (result.median > 0.)
+    {
+      result.itemsPerSecond = throughput.items / result.median;
+      result.gigabytesPerSecond = throughput.bytes / result.median * 1e-9;
+    }
+
+    print(result);
+
+    results_.push_back(std::move(result));
+    return results_.back();
+  }
+
+  const auto& results() const noexcept { return results_; }
+
+  void save() const
+  {
+    if (!options_.jsonFilepath.empty())
+      saveJson(options_.jsonFilepath);
+
+    if (!options_.csvFilepath.empty())
+      saveCsv(options_.csvFilepath);
+  }
+
+private:
+  void print(const Result& result) const
+  {
+    std::cout << "  " << result.name;
+    for (const auto& parameter : result.parameters)
+      std::cout << ' ' << parameter.first << '=' << parameter.second;
+
+    std::cout << std::fixed << std::setprecision(3)
+      << ": min " << result.min * 1e3 << " ms"
+      << ", median " << result.median * 1e3 << " ms"
+      << ", p95 " << result.p95 * 1e3 << " ms";
+
+    if (result.throughput.items > 0.)
+      std::cout << ", " << result.itemsPerSecond * 1e-6 << " M" << result.throughput.itemUnit << "/s";
+    if (result.throughput.bytes > 0.)
+      std::cout << ", " << result.gigabytesPerSecond << " GB/s";
+
+    std::cout << std::defaultfloat << std::endl;
+  }
+
+  void saveJson(const std::string& filepath) const
+  {
+    std::ofstream out(filepath);
+    if (!out)
+      throw std::runtime_error("Failed to open file: " + filepath);
+
+    out << std::setprecision(9);
+    out << "{\"benchmark\":\"" << escapeJson(name_) << "\""
+      << ",\"warmup\":" << options_.warmup
+      << ",\"repetitions\":" << options_.repetitions
+      << ",\"results\":[" << std::endl;
+
+    for (size_t i = 0; i < results_.size(); i++)
+    {
+      const auto& result = results_[i];
+
+      out << "{\"name\":\"" << escapeJson(result.name) << "\",\"parameters\":{";
+      for (size_t j = 0; j < result.parameters.size(); j++)
+      {
+        if (j > 0)
+          out << ',';
+        out << '"' << escapeJson(result.parameters[j].first) << "\":\"" << escapeJson(result.parameters[j].second) << '"';
+      }
+      out << "}"
+        << ",\"min\":" << result.min
+        << ",\"median\":" << result.median
+        << ",\"p95\":" << result.p95
+        << ",\"mean\":" << result.mean
+        << ",\"itemUnit\":\"" << escapeJson(result.throughput.itemUnit) << "\""
+        << ",\"itemsPerSecond\":" << result.itemsPerSecond
+        << ",\"gigabytesPerSecond\":" << result.gigabytesPerSecond
+        << ",\"samples\":[";
+      for (size_t j = 0; j < result.samples.size(); j++)
+      {
+        if (j > 0)
+          out << ',';
+        out << result.samples[j];
+      }
+      out << "]}" << (i + 1 < results_.size() ? "," : "") << std::endl;
+    }
+
+    out << "]}" << std::endl;
+  }
+
+  void saveCsv(const std::string& filepath) const
+  {
+    std::ofstream out(filepath);
+    if (!out)
+      throw std::runtime_error("Failed to open file: " + filepath);
+
+    // One column per parameter name, in order of first appearance
+    std::vector<std::string> parameterNames;
+    for (const auto& result : results_)
+    {
+      for (const auto& parameter : result.parameters)
+      {
+        if (std::find(parameterNames.begin(), parameterNames.end(), parameter.first) == parameterNames.end())
+          parameterNames.push_back(parameter.first);
+      }
+    }
+
+    out << "name";
+    for (const auto& parameterName : parameterNames)
+      out << ',' << escapeCsv(parameterName);
+    out << ",min,median,p95,mean,item_unit,items_per_second,gigabytes_per_second" << std::endl;
+
+    out << std::setprecision(9);
+    for (const auto& result : results_)
+    {
+      out << escapeCsv(result.name);
+      for (const auto& parameterName : parameterNames)
+      {
+        out << ',';
+        for (const auto& parameter : result.parameters)
+        {
+          if (parameter.first == parameterName)
+            out << escapeCsv(parameter.second);
+        }
+      }
+      out << ',' << result.min
+        << ',' << result.median
+        << ',' << result.p95
+        << ',' << result.mean
+        << ',' << escapeCsv(result.throughput.itemUnit)
+        << ',' << result.itemsPerSecond
+        << ',' << result.gigabytesPerSecond
+        << std::endl;
+    }
+  }
+
+  std::string name_;
+  Options options_;
+  std::vector<Result> results_;
+};
+
+Benchmark::Options Benchmark::parseArguments(int argc, char** argv)
+{
+  return parseArguments(argc, argv, Options());
+}
+
+Benchmark::Options Benchmark::parseArguments(int argc, char** argv, Options options)
+{
+  const auto value = [](const char* argument, const char* prefix) -> const char*
+  {
+    const auto length = std::strlen(prefix);
+    return std::strncmp(argument, prefix, length) == 0 ? argument + length : nullptr;
+  };
+
+  for (int i = 1; i < argc; i++)
+  {
+    if (const auto warmup = value(argv[i], "--warmup="))
+      options.warmup = static_cast<uint32_t>(std::stoul(warmup));
+    else if (const auto repetitions = value(argv[i], "--repetitions="))
+      options.repetitions = static_cast<uint32_t>(std::stoul(repetitions));
+    else if (const auto json = value(argv[i], "--json="))
+      options.jsonFilepath = json;
+    else if (const auto csv = value(argv[i], "--csv="))
+      options.csvFilepath = csv;
+  }
+
+  return options;
+}
+
+gpu::Engine::Options Benchmark::engineOptions(gpu::Engine::Options options)
+{
+  options.validationLayer = false;
+  return options;
+}
+
+std::vector<uint64_t> Benchmark::powersOfTwo(uint32_t firstExponent, uint32_t lastExponent)
+{
+  std::vector<uint64_t> values;
+  for (auto exponent = firstExponent; exponent <= lastExponent; exponent++)
+    values.push_back(1ull << exponent);
+  return values;
+}
+
+Benchmark::Benchmark(const std::string& name, const Options& options)
+  : impl_(std::make_shared<Impl>(name, options))
+{
+}
+
+Benchmark::~Benchmark() = default;
+
+Result Benchmark::run(const std::string& name, const Parameters& parameters, const Throughput& throughput, std::function<void()> function)
+{
+  return impl_->run(name, parameters, throughput, [&function]()
+    {
+      utils::Timer timer;
+      function();
+      return timer.elapsed();
+    });
+}
+
+Result Benchmark::runTimed(const std::string& name, const Parameters& parameters, const Throughput& throughput, std::function<double()> function)
+{
+  return impl_->run(name, parameters, throughput, std::move(function));
+}
+
+const std::vector<Result>& Benchmark::results() const noexcept
+{
+  return impl_->results();
+}
+
+void Benchmark::save() const
+{
+  impl_->save();
+}
+}
+}
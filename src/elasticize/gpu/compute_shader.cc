@@ -1,6 +1,9 @@
 #include <elasticize/gpu/compute_shader.h>
 
 #include <fstream>
+#include <future>
+#include <thread>
+#include <algorithm>
 
 #include <elasticize/gpu/engine.h>
 #include <elasticize/gpu/descriptor_set_layout.h>
@@ -9,6 +12,68 @@ namespace elastic
 {
 namespace gpu
 {
+namespace
+{
+vk::PipelineLayout createPipelineLayout(vk::Device device,
+  DescriptorSetLayout descriptorSetLayout,
+  const std::vector<PushConstantRange>& pushConstantRanges)
+{
+  // Without explicit ranges, reserve the 128 bytes every device guarantees, enough for a few device addresses
+  constexpr uint32_t defaultPushConstantSize = 128;
+
+  std::vector<vk::PushConstantRange> pushConstantRange;
+  for (const auto& range : pushConstantRanges)
+  {
+    pushConstantRange.push_back(vk::PushConstantRange()
+      .setStageFlags(vk::ShaderStageFlagBits::eCompute)
+      .setOffset(range.offset)
+      .setSize(range.size));
+  }
+
+  if (pushConstantRange.empty())
+  {
+    pushConstantRange.push_back(vk::PushConstantRange()
+      .setStageFlags(vk::ShaderStageFlagBits::eCompute)
+      .setOffset(0)
+      .setSize(defaultPushConstantSize));
+  }
+
+  vk::DescriptorSetLayout setLayout = descriptorSetLayout;
+
+  const auto pipelineLayoutInfo = vk::PipelineLayoutCreateInfo()
+    .setSetLayouts(setLayout)
+    .setPushConstantRanges(pushConstantRange);
+
+  return device.createPipelineLayout(pipelineLayoutInfo);
+}
+
+// Maps specialization constant i to the i-th uint32_t of data
+std::vector<vk::SpecializationMapEntry> specializationMapEntries(const std::vector<uint32_t>& specializationConstants)
+{
+  std::vector<vk::SpecializationMapEntry> mapEntries;
+  for (uint32_t i = 0; i < specializationConstants.size(); i++)
+  {
+    mapEntries.push_back(vk::SpecializationMapEntry()
+      .setConstantID(i)
+      .setOffset(sizeof(uint32_t) * i)
+      .setSize(sizeof(uint32_t)));
+  }
+  return mapEntries;
+}
+
+// File name without directory and .spv extension
+std::string shaderName(const std::string& filepath)
+{
+  auto name = filepath.substr(filepath.find_last_of("/\\") + 1);
+
+  const std::string extension = ".spv";
+  if (name.size() > extension.size() && name.compare(name.size() - extension.size(), extension.size(), extension) == 0)
+    name.resize(name.size() - extension.size());
+
+  return name;
+}
+}
+
 class ComputeShader::Impl
 {
 public:
@@ -17,42 +82,45 @@ public:
   Impl(Engine engine,
     const std::string& filepath,
     DescriptorSetLayout descriptorSetLayout,
-    const std::vector<PushConstantRange>& pushConstantRanges)
+    const std::vector<PushConstantRange>& pushConstantRanges,
+    const std::vector<uint32_t>& specializationConstants)
     : engine_(engine)
+    , descriptorSetLayout_(descriptorSetLayout)
   {
     auto device = engine_.device();
 
-    // Pipeline layout
-    // TODO: push constants
-    std::vector<vk::PushConstantRange> pushConstantRange(1);
-    pushConstantRange[0]
-      .setStageFlags(vk::ShaderStageFlagBits::eCompute)
-      .setOffset(0)
-      .setSize(sizeof(uint32_t) * 3);
-
-    vk::DescriptorSetLayout setLayout = descriptorSetLayout;
-
-    const auto pipelineLayoutInfo = vk::PipelineLayoutCreateInfo()
-      .setSetLayouts(setLayout)
-      .setPushConstantRanges(pushConstantRange);
-
-    pipelineLayout_ = device.createPipelineLayout(pipelineLayoutInfo);
+    // Owned until the pipeline exists, so that a failure on the way destroys them
+    vk::UniquePipelineLayout pipelineLayout(createPipelineLayout(device, descriptorSetLayout, pushConstantRanges), device);
+    const vk::UniqueShaderModule module(engine.createShaderModule(filepath), device);
 
-    // Pipeline
-    const auto module = engine.createShaderModule(filepath);
+    const auto mapEntries = specializationMapEntries(specializationConstants);
+    const auto specializationInfo = vk::SpecializationInfo()
+      .setMapEntries(mapEntries)
+      .setData<uint32_t>(specializationConstants);
 
     const auto stage = vk::PipelineShaderStageCreateInfo()
       .setStage(vk::ShaderStageFlagBits::eCompute)
-      .setModule(module)
-      .setPName("main");
+      .setModule(*module)
+      .setPName("main")
+      .setPSpecializationInfo(&specializationInfo);
 
     const auto pipelineInfo = vk::ComputePipelineCreateInfo()
-      .setLayout(pipelineLayout_)
+      .setLayout(*pipelineLayout)
       .setStage(stage);
 
-    pipeline_ = device.createComputePipeline(nullptr, pipelineInfo).value;
+    pipeline_ = device.createComputePipeline(engine_.pipelineCache(), pipelineInfo).value;
+    pipelineLayout_ = pipelineLayout.release();
+
+    setName(shaderName(filepath));
+  }
 
-    device.destroyShaderModule(module);
+  // Takes ownership of already created objects
+  Impl(Engine engine, DescriptorSetLayout descriptorSetLayout, vk::PipelineLayout pipelineLayout, vk::Pipeline pipeline)
+    : engine_(engine)
+    , descriptorSetLayout_(descriptorSetLayout)
+    , pipelineLayout_(pipelineLayout)
+    , pipeline_(pipeline)
+  {
   }
 
   ~Impl()
@@ -65,19 +133,130 @@ public:
 
   auto pipelineLayout() const noexcept { return pipelineLayout_; }
   auto pipeline() const noexcept { return pipeline_; }
+  auto descriptorSetLayout() const noexcept { return descriptorSetLayout_; }
+
+  const auto& name() const noexcept { return name_; }
+
+  void setName(const std::string& name)
+  {
+    name_ = name;
+    engine_.setObjectName(pipeline_, name);
+    engine_.setObjectName(pipelineLayout_, name);
+  }
 
 private:
   Engine engine_;
+  DescriptorSetLayout descriptorSetLayout_;
 
   vk::PipelineLayout pipelineLayout_;
   vk::Pipeline pipeline_;
+  std::string name_;
 };
 
+std::vector<ComputeShader> ComputeShader::createMany(Engine engine, const std::vector<CreateInfo>& createInfos)
+{
+  auto device = engine.device();
+  auto pipelineCache = engine.pipelineCache();
+
+  const auto count = createInfos.size();
+  std::vector<vk::PipelineLayout> pipelineLayouts(count);
+  std::vector<vk::Pipeline> pipelines(count);
+
+  // Split into contiguous batches, one per worker
+  const size_t threadCount = std::max<size_t>(1, std::min<size_t>(std::thread::hardware_concurrency(), count));
+  const size_t batchSize = count == 0 ? 0 : (count + threadCount - 1) / threadCount;
+
+  const auto createBatch = [&](size_t first, size_t last)
+  {
+    // Destroyed when the batch returns or throws
+    std::vector<vk::UniqueShaderModule> modules;
+    std::vector<vk::ComputePipelineCreateInfo> pipelineInfos;
+
+    // Referenced by pipelineInfos until pipelines are created
+    std::vector<std::vector<vk::SpecializationMapEntry>> mapEntries(last - first);
+    std::vector<vk::SpecializationInfo> specializationInfos(last - first);
+
+    for (size_t i = first; i < last; i++)
+    {
+      const auto& createInfo = createInfos[i];
+
+      pipelineLayouts[i] = createPipelineLayout(device, createInfo.descriptorSetLayout, createInfo.pushConstantRanges);
+      modules.emplace_back(engine.createShaderModule(createInfo.filepath), device);
+
+      mapEntries[i - first] = specializationMapEntries(createInfo.specializationConstants);
+      specializationInfos[i - first]
+        .setMapEntries(mapEntries[i - first])
+        .setData<uint32_t>(createInfo.specializationConstants);
+
+      const auto stage = vk::PipelineShaderStageCreateInfo()
+        .setStage(vk::ShaderStageFlagBits::eCompute)
+        .setModule(*modules.back())
+        .setPName("main")
+        .setPSpecializationInfo(&specializationInfos[i - first]);
+
+      pipelineInfos.push_back(vk::ComputePipelineCreateInfo()
+        .setLayout(pipelineLayouts[i])
+        .setStage(stage));
+    }
+
+    const auto batchPipelines = device.createComputePipelines(pipelineCache, pipelineInfos).value;
+    std::copy(batchPipelines.begin(), batchPipelines.end(), pipelines.begin() + first);
+  };
+
+  std::vector<std::future<void>> batches;
+  for (size_t first = 0; first < count; first += batchSize)
+    batches.push_back(std::async(std::launch::async, createBatch, first, std::min(first + batchSize, count)));
+
+  // Wait for all workers before reporting the first failure
+  std::exception_ptr exception;
+  for (auto& batch : batches)
+  {
+    try
+    {
+      batch.get();
+    }
+    catch (...)
+    {
+      if (!exception)
+        exception = std::current_exception();
+    }
+  }
+
+  if (exception)
+  {
+    for (size_t i = 0; i < count; i++)
+    {
+      device.destroyPipeline(pipelines[i]);
+      device.destroyPipelineLayout(pipelineLayouts[i]);
+    }
+    std::rethrow_exception(exception);
+  }
+
+  std::vector<ComputeShader> computeShaders;
+  for (size_t i = 0; i < count; i++)
+  {
+    computeShaders.push_back(ComputeShader(std::make_shared<Impl>(engine, createInfos[i].descriptorSetLayout, pipelineLayouts[i], pipelines[i])));
+    computeShaders.back().setName(shaderName(createInfos[i].filepath));
+  }
+
+  return computeShaders;
+}
+
 ComputeShader::ComputeShader(Engine engine,
   const std::string& filepath,
   DescriptorSetLayout descriptorSetLayout,
   const std::vector<PushConstantRange>& pushConstantRanges)
-  : impl_(std::make_shared<Impl>(engine, filepath, descriptorSetLayout, pushConstantRanges))
+  : impl_(std::make_shared<Impl>(engine, filepath, descriptorSetLayout, pushConstantRanges, std::vector<uint32_t>()))
+{
+}
+
+ComputeShader::ComputeShader(Engine engine, const CreateInfo& createInfo)
+  : impl_(std::make_shared<Impl>(engine, createInfo.filepath, createInfo.descriptorSetLayout, createInfo.pushConstantRanges, createInfo.specializationConstants))
+{
+}
+
+ComputeShader::ComputeShader(std::shared_ptr<Impl> impl)
+  : impl_(std::move(impl))
 {
 }
 
@@ -93,5 +272,20 @@ vk::Pipeline ComputeShader::pipeline() const noexcept
   return impl_->pipeline();
 }
 
+DescriptorSetLayout ComputeShader::descriptorSetLayout() const noexcept
+{
+  return impl_->descriptorSetLayout();
+}
+
+const std::string& ComputeShader::name() const noexcept
+{
+  return impl_->name();
+}
+
+void ComputeShader::setName(const std::string& name)
+{
+  impl_->setName(name);
+}
+
 }
 }
@@ -17,48 +17,15 @@ public:
     std::initializer_list<BufferProxy> bufferProxies)
     : engine_(engine)
   {
-    auto device = engine_.device();
-    auto descriptorPool = engine_.descriptorPool();
-
-    std::vector<vk::Buffer> buffers;
+    std::vector<vk::DescriptorBufferInfo> bufferInfos;
     for (auto bufferProxy : bufferProxies)
-      buffers.push_back(bufferProxy);
-
-    vk::DescriptorSetLayout setLayout = descriptorSetLayout;
-
-    const auto descriptorSetAllocateInfo = vk::DescriptorSetAllocateInfo()
-      .setDescriptorPool(descriptorPool)
-      .setSetLayouts(setLayout);
-
-    descriptorSet_ = device.allocateDescriptorSets(descriptorSetAllocateInfo)[0];
-
-    std::vector<vk::DescriptorBufferInfo> bufferInfos(buffers.size());
-    std::vector<vk::WriteDescriptorSet> writes(buffers.size());
-    for (int i = 0; i < buffers.size(); i++)
-    {
-      bufferInfos[i]
-        .setBuffer(buffers[i])
-        .setOffset(0)
-        .setRange(VK_WHOLE_SIZE);
+      bufferInfos.push_back(bufferProxy.bufferInfo());
 
-      writes[i]
-        .setDstBinding(i)
-        .setDstSet(descriptorSet_)
-        .setDescriptorType(vk::DescriptorType::eStorageBuffer)
-        .setDescriptorCount(1)
-        .setBufferInfo(bufferInfos[i]);
-    }
-
-    device.updateDescriptorSets(writes, {});
+    // Identical bindings share the engine's cached descriptor set, owned by the engine
+    descriptorSet_ = engine_.descriptorSet(descriptorSetLayout, descriptorSetLayout.descriptorTypes(), bufferInfos);
   }
 
-  ~Impl()
-  {
-    auto device = engine_.device();
-    auto descriptorPool = engine_.descriptorPool();
-
-    device.freeDescriptorSets(descriptorPool, descriptorSet_);
-  }
+  ~Impl() = default;
 
   operator vk::DescriptorSet() const noexcept { return descriptorSet_; }
 
@@ -11,43 +11,56 @@ class DescriptorSetLayout::Impl
 public:
   Impl() = delete;
 
-  Impl(Engine engine, uint32_t storageBufferCount)
+  Impl(Engine engine, const std::vector<vk::DescriptorType>& descriptorTypes, bool pushDescriptor)
     : engine_(engine)
+    , descriptorTypes_(descriptorTypes)
+    , pushDescriptor_(pushDescriptor && engine.pushDescriptorSupported())
   {
     auto device = engine_.device();
 
     // Descriptor set layout
-    std::vector<vk::DescriptorSetLayoutBinding> bindings(storageBufferCount);
-    for (uint32_t i = 0; i < storageBufferCount; i++)
+    std::vector<vk::DescriptorSetLayoutBinding> bindings(descriptorTypes.size());
+    for (uint32_t i = 0; i < descriptorTypes.size(); i++)
     {
       bindings[i]
         .setBinding(i)
         .setStageFlags(vk::ShaderStageFlagBits::eCompute)
-        .setDescriptorType(vk::DescriptorType::eStorageBuffer)
+        .setDescriptorType(descriptorTypes[i])
         .setDescriptorCount(1);
     }
 
-    const auto descriptorSetLayoutInfo = vk::DescriptorSetLayoutCreateInfo().setBindings(bindings);
+    auto descriptorSetLayoutInfo = vk::DescriptorSetLayoutCreateInfo().setBindings(bindings);
+    if (pushDescriptor_)
+      descriptorSetLayoutInfo.setFlags(vk::DescriptorSetLayoutCreateFlagBits::ePushDescriptorKHR);
+
     descriptorSetLayout_ = device.createDescriptorSetLayout(descriptorSetLayoutInfo);
   }
 
   ~Impl()
   {
-    auto device = engine_.device();
-
-    device.destroyDescriptorSetLayout(descriptorSetLayout_);
+    engine_.destroyDescriptorSetLayout(descriptorSetLayout_);
   }
 
   operator vk::DescriptorSetLayout() const noexcept { return descriptorSetLayout_; }
 
+  const auto& descriptorTypes() const noexcept { return descriptorTypes_; }
+  auto pushDescriptor() const noexcept { return pushDescriptor_; }
+
 private:
   Engine engine_;
 
   vk::DescriptorSetLayout descriptorSetLayout_;
+  std::vector<vk::DescriptorType> descriptorTypes_;
+  bool pushDescriptor_ = false;
 };
 
 DescriptorSetLayout::DescriptorSetLayout(Engine engine, uint32_t storageBufferCount)
-  : impl_(std::make_shared<Impl>(engine, storageBufferCount))
+  : impl_(std::make_shared<Impl>(engine, std::vector<vk::DescriptorType>(storageBufferCount, vk::DescriptorType::eStorageBuffer), false))
+{
+}
+
+DescriptorSetLayout::DescriptorSetLayout(Engine engine, const std::vector<vk::DescriptorType>& descriptorTypes, bool pushDescriptor)
+  : impl_(std::make_shared<Impl>(engine, descriptorTypes, pushDescriptor))
 {
 }
 
@@ -57,5 +70,15 @@ DescriptorSetLayout::operator vk::DescriptorSetLayout() const noexcept
 {
   return *impl_;
 }
+
+const std::vector<vk::DescriptorType>& DescriptorSetLayout::descriptorTypes() const noexcept
+{
+  return impl_->descriptorTypes();
+}
+
+bool DescriptorSetLayout::pushDescriptor() const noexcept
+{
+  return impl_->pushDescriptor();
+}
 }
 }
@@ -2,6 +2,18 @@
 
 #include <iostream>
 #include <fstream>
+#include <map>
+#include <algorithm>
+#include <cstring>
+#include <array>
+#include <atomic>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#endif
 
 #include <elasticize/window/window_manager.h>
 #include <elasticize/window/window.h>
@@ -14,6 +26,19 @@ namespace gpu
 {
 namespace
 {
+#if defined(VULKAN_VALIDATION) || defined(ELASTICIZE_DEBUG_UTILS)
+constexpr bool debugUtilsCompiled = true;
+#else
+constexpr bool debugUtilsCompiled = false;
+#endif
+
+// Host clock domain that std::chrono::steady_clock is built on
+#ifdef _WIN32
+constexpr auto hostTimeDomain = vk::TimeDomainEXT::eQueryPerformanceCounter;
+#else
+constexpr auto hostTimeDomain = vk::TimeDomainEXT::eClockMonotonic;
+#endif
+
 // Validation layer callback
 VKAPI_ATTR VkBool32 VKAPI_CALL debugCallback(
   VkDebugUtilsMessageSeverityFlagBitsEXT messageSeverity,
@@ -44,6 +69,7 @@ public:
     createMemoryPool();
     createCommandPool();
     createDescriptorPool();
+    createPipelineCache();
   }
 
   ~Impl()
@@ -57,6 +83,7 @@ public:
       device_.destroyPipeline(computePipeline.pipeline);
     }
 
+    destroyPipelineCache();
     destroyDescriptorPool();
     destroyCommandPool();
     destroyMemoryPool();
@@ -70,9 +97,83 @@ public:
   auto queueIndex() const noexcept { return queueIndex_; }
   auto device() const noexcept { return device_; }
   auto transientCommandPool() const noexcept { return transientCommandPool_; }
-  auto descriptorPool() const noexcept { return descriptorPool_; }
+  auto descriptorPool() const noexcept { return descriptorPools_.front(); }
+  auto pipelineCache() const noexcept { return pipelineCache_; }
+  const auto& dispatchLoader() const noexcept { return dld_; }
+  auto pushDescriptorSupported() const noexcept { return pushDescriptorSupported_; }
+  auto bufferDeviceAddressSupported() const noexcept { return bufferDeviceAddressSupported_; }
+  auto pipelineStatisticsSupported() const noexcept { return pipelineStatisticsSupported_; }
+  auto calibratedTimestampsSupported() const noexcept { return calibratedTimestampsSupported_; }
+  auto debugUtilsEnabled() const noexcept { return debugUtilsEnabled_; }
+  auto minSubgroupSize() const noexcept { return minSubgroupSize_; }
+  auto maxSubgroupSize() const noexcept { return maxSubgroupSize_; }
+
+  void addCounter(Counter counter, uint64_t value) noexcept
+  {
+    counters_[static_cast<size_t>(counter)].fetch_add(value, std::memory_order_relaxed);
+  }
+
+  Counters counters(bool reset) noexcept
+  {
+    std::array<uint64_t, static_cast<size_t>(Counter::Count)> values;
+    for (size_t i = 0; i < values.size(); i++)
+      values[i] = reset ? counters_[i].exchange(0, std::memory_order_relaxed) : counters_[i].load(std::memory_order_relaxed);
+
+    const auto value = [&values](Counter counter) { return values[static_cast<size_t>(counter)]; };
+
+    Counters result;
+    result.submits = value(Counter::Submits);
+    result.dispatches = value(Counter::Dispatches);
+    result.draws = value(Counter::Draws);
+    result.barriers = value(Counter::Barriers);
+    result.pipelineBinds = value(Counter::PipelineBinds);
+    result.descriptorSetAllocations = value(Counter::DescriptorSetAllocations);
+    result.bytesUploaded = value(Counter::BytesUploaded);
+    result.bytesReadBack = value(Counter::BytesReadBack);
+    result.bytesCopied = value(Counter::BytesCopied);
+    result.fenceWaitNanoseconds = value(Counter::FenceWaitNanoseconds);
+    return result;
+  }
+
+  void setObjectName(vk::ObjectType objectType, uint64_t handle, const std::string& name)
+  {
+    if (!debugUtilsEnabled_)
+      return;
+
+    const auto nameInfo = vk::DebugUtilsObjectNameInfoEXT()
+      .setObjectType(objectType)
+      .setObjectHandle(handle)
+      .setPObjectName(name.c_str());
+    device_.setDebugUtilsObjectNameEXT(nameInfo, dld_);
+  }
   auto stagingBuffer() const noexcept { return stagingBuffer_; }
 
+  std::pair<uint64_t, std::chrono::steady_clock::time_point> calibrateTimestamps()
+  {
+    std::array<vk::CalibratedTimestampInfoEXT, 2> timestampInfos;
+    timestampInfos[0].setTimeDomain(vk::TimeDomainEXT::eDevice);
+    timestampInfos[1].setTimeDomain(hostTimeDomain);
+
+    std::array<uint64_t, 2> timestamps;
+    uint64_t maxDeviation = 0;
+    const auto result = device_.getCalibratedTimestampsEXT(static_cast<uint32_t>(timestampInfos.size()), timestampInfos.data(), timestamps.data(), &maxDeviation, dld_);
+    if (result != vk::Result::eSuccess)
+      throw std::runtime_error("Failed to get calibrated timestamps: " + vk::to_string(result));
+
+    // steady_clock counts from the same origin as the host domain, only the unit differs
+#ifdef _WIN32
+    LARGE_INTEGER frequency;
+    QueryPerformanceFrequency(&frequency);
+    const auto hostNanoseconds = static_cast<uint64_t>(static_cast<double>(timestamps[1]) * 1e9 / static_cast<double>(frequency.QuadPart));
+#else
+    const auto hostNanoseconds = timestamps[1];
+#endif
+
+    const auto hostTime = std::chrono::steady_clock::time_point(
+      std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::nanoseconds(hostNanoseconds)));
+    return { timestamps[0], hostTime };
+  }
+
   void fromStagingBuffer(void* target, vk::DeviceSize srcOffset, vk::DeviceSize size)
   {
     std::memcpy(target, stagingBufferMap_ + srcOffset, size);
@@ -85,10 +186,14 @@ public:
 
   vk::Buffer createBuffer(vk::DeviceSize size)
   {
+    vk::BufferUsageFlags usage =
+      vk::BufferUsageFlagBits::eStorageBuffer | vk::BufferUsageFlagBits::eUniformBuffer | vk::BufferUsageFlagBits::eTransferSrc | vk::BufferUsageFlagBits::eTransferDst |
+      vk::BufferUsageFlagBits::eVertexBuffer | vk::BufferUsageFlagBits::eIndexBuffer;
+    if (bufferDeviceAddressSupported_)
+      usage |= vk::BufferUsageFlagBits::eShaderDeviceAddress;
+
     const auto bufferInfo = vk::BufferCreateInfo()
-      .setUsage(
-        vk::BufferUsageFlagBits::eStorageBuffer | vk::BufferUsageFlagBits::eTransferSrc | vk::BufferUsageFlagBits::eTransferDst |
-        vk::BufferUsageFlagBits::eVertexBuffer | vk::BufferUsageFlagBits::eIndexBuffer)
+      .setUsage(usage)
       .setSize(size);
 
     auto buffer = device_.createBuffer(bufferInfo);
@@ -109,6 +214,81 @@ public:
     deviceMemoryOffset_ += memoryRequirements.size;
   }
 
+  vk::DeviceAddress bufferDeviceAddress(vk::Buffer buffer) const
+  {
+    if (!bufferDeviceAddressSupported_)
+      throw std::runtime_error("Buffer device address is not supported");
+
+    return device_.getBufferAddress(vk::BufferDeviceAddressInfo().setBuffer(buffer));
+  }
+
+  void destroyBuffer(vk::Buffer buffer)
+  {
+    // Cached descriptor sets must not outlive the buffers written to them
+    for (auto it = descriptorSets_.begin(); it != descriptorSets_.end();)
+    {
+      const auto& buffers = it->first.second;
+      if (std::find(buffers.begin(), buffers.end(), buffer) != buffers.end())
+      {
+        freeDescriptorSet(it->second.descriptorPool, it->second.descriptorSet);
+        it = descriptorSets_.erase(it);
+      }
+      else
+        it++;
+    }
+
+    device_.destroyBuffer(buffer);
+  }
+
+  vk::DescriptorSet descriptorSet(vk::DescriptorSetLayout layout, const std::vector<vk::DescriptorType>& descriptorTypes, const std::vector<vk::DescriptorBufferInfo>& bufferInfos)
+  {
+    // Ranges are fixed per buffer (whole buffer, or one element of a dynamic uniform buffer), so buffers identify the set
+    std::vector<vk::Buffer> buffers;
+    for (const auto& bufferInfo : bufferInfos)
+      buffers.push_back(bufferInfo.buffer);
+
+    auto key = std::make_pair(layout, std::move(buffers));
+    auto it = descriptorSets_.find(key);
+    if (it != descriptorSets_.end())
+      return it->second.descriptorSet;
+
+    const auto allocation = allocateDescriptorSet(layout);
+    const auto descriptorSet = allocation.second;
+    addCounter(Counter::DescriptorSetAllocations, 1);
+
+    std::vector<vk::WriteDescriptorSet> writes(bufferInfos.size());
+    for (int i = 0; i < bufferInfos.size(); i++)
+    {
+      writes[i]
+        .setDstBinding(i)
+        .setDstSet(descriptorSet)
+        .setDescriptorType(descriptorTypes[i])
+        .setDescriptorCount(1)
+        .setBufferInfo(bufferInfos[i]);
+    }
+
+    device_.updateDescriptorSets(writes, {});
+
+    descriptorSets_.emplace(std::move(key), CachedDescriptorSet{ allocation.first, descriptorSet });
+    return descriptorSet;
+  }
+
+  void destroyDescriptorSetLayout(vk::DescriptorSetLayout layout)
+  {
+    for (auto it = descriptorSets_.begin(); it != descriptorSets_.end();)
+    {
+      if (it->first.first == layout)
+      {
+        freeDescriptorSet(it->second.descriptorPool, it->second.descriptorSet);
+        it = descriptorSets_.erase(it);
+      }
+      else
+        it++;
+    }
+
+    device_.destroyDescriptorSetLayout(layout);
+  }
+
   vk::ShaderModule createShaderModule(const std::string& filepath)
   {
     std::ifstream file(filepath, std::ios::ate | std::ios::binary);
@@ -143,6 +323,20 @@ private:
       instanceExtensions.push_back(VK_EXT_DEBUG_UTILS_EXTENSION_NAME);
     }
 
+    // Object names and labels, without the validation layer if need be
+    if (debugUtilsCompiled && options_.debugUtils)
+    {
+      const auto availableExtensions = vk::enumerateInstanceExtensionProperties();
+      for (const auto& availableExtension : availableExtensions)
+      {
+        if (std::strcmp(availableExtension.extensionName, VK_EXT_DEBUG_UTILS_EXTENSION_NAME) == 0)
+          debugUtilsEnabled_ = true;
+      }
+
+      if (debugUtilsEnabled_ && !options_.validationLayer)
+        instanceExtensions.push_back(VK_EXT_DEBUG_UTILS_EXTENSION_NAME);
+    }
+
     if (!options_.headless)
     {
       const auto windowInstanceExtensions = window::WindowManager::requiredInstanceExtensions();
@@ -224,6 +418,49 @@ private:
     if (!options_.headless)
       deviceExtensions.push_back(VK_KHR_SWAPCHAIN_EXTENSION_NAME);
 
+    // Optional extensions
+    const auto availableExtensions = physicalDevice_.enumerateDeviceExtensionProperties();
+    const auto extensionAvailable = [&availableExtensions](const char* extensionName)
+    {
+      for (const auto& availableExtension : availableExtensions)
+      {
+        if (std::strcmp(availableExtension.extensionName, extensionName) == 0)
+          return true;
+      }
+      return false;
+    };
+
+    pushDescriptorSupported_ = extensionAvailable(VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME);
+    if (pushDescriptorSupported_)
+      deviceExtensions.push_back(VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME);
+
+    // Calibration needs both the device and the host steady clock domain
+    if (extensionAvailable(VK_EXT_CALIBRATED_TIMESTAMPS_EXTENSION_NAME))
+    {
+      const vk::DispatchLoaderDynamic instanceDld(instance_, vkGetInstanceProcAddr);
+      const auto timeDomains = physicalDevice_.getCalibrateableTimeDomainsEXT(instanceDld);
+      const auto timeDomainAvailable = [&timeDomains](vk::TimeDomainEXT timeDomain)
+      {
+        return std::find(timeDomains.begin(), timeDomains.end(), timeDomain) != timeDomains.end();
+      };
+
+      calibratedTimestampsSupported_ = timeDomainAvailable(vk::TimeDomainEXT::eDevice) && timeDomainAvailable(hostTimeDomain);
+      if (calibratedTimestampsSupported_)
+        deviceExtensions.push_back(VK_EXT_CALIBRATED_TIMESTAMPS_EXTENSION_NAME);
+    }
+
+    // Compute shaders may run with any subgroup size in this range, only the reported one without subgroup size control
+    const auto subgroupProperties = physicalDevice_.getProperties2<vk::PhysicalDeviceProperties2, vk::PhysicalDeviceSubgroupProperties>();
+    minSubgroupSize_ = subgroupProperties.get<vk::PhysicalDeviceSubgroupProperties>().subgroupSize;
+    maxSubgroupSize_ = minSubgroupSize_;
+    if (extensionAvailable(VK_EXT_SUBGROUP_SIZE_CONTROL_EXTENSION_NAME))
+    {
+      const auto sizeControlProperties = physicalDevice_.getProperties2<vk::PhysicalDeviceProperties2, vk::PhysicalDeviceSubgroupSizeControlPropertiesEXT>();
+      const auto& sizeControl = sizeControlProperties.get<vk::PhysicalDeviceSubgroupSizeControlPropertiesEXT>();
+      minSubgroupSize_ = sizeControl.minSubgroupSize;
+      maxSubgroupSize_ = sizeControl.maxSubgroupSize;
+    }
+
     const auto queueFamilyProperties = physicalDevice_.getQueueFamilyProperties();
     queueIndex_ = 0;
     for (int i = 0; i < queueFamilyProperties.size(); i++)
@@ -246,12 +483,30 @@ private:
       .setQueueFamilyIndex(queueIndex_)
       .setPQueuePriorities(queuePriorities);
 
+    // Features, enabled only when available
+    const auto availableFeatures = physicalDevice_.getFeatures2<vk::PhysicalDeviceFeatures2, vk::PhysicalDeviceVulkan12Features>();
+    const auto& availableFeatures12 = availableFeatures.get<vk::PhysicalDeviceVulkan12Features>();
+
+    bufferDeviceAddressSupported_ = availableFeatures12.bufferDeviceAddress;
+    pipelineStatisticsSupported_ = availableFeatures.get<vk::PhysicalDeviceFeatures2>().features.pipelineStatisticsQuery;
+
+    vk::PhysicalDeviceFeatures2 features;
+    features.features.setPipelineStatisticsQuery(pipelineStatisticsSupported_);
+    vk::PhysicalDeviceVulkan12Features features12;
+    features12.setBufferDeviceAddress(bufferDeviceAddressSupported_);
+
     auto deviceInfo = vk::DeviceCreateInfo()
       .setPEnabledExtensionNames(deviceExtensions)
       .setQueueCreateInfos(queueInfos);
 
-    device_ = physicalDevice_.createDevice(deviceInfo);
+    vk::StructureChain<vk::DeviceCreateInfo, vk::PhysicalDeviceFeatures2, vk::PhysicalDeviceVulkan12Features> chain{
+      deviceInfo, features, features12
+    };
+    device_ = physicalDevice_.createDevice(chain.get<vk::DeviceCreateInfo>());
     queue_ = device_.getQueue(queueIndex_, 0);
+
+    // Extension function pointers
+    dld_ = vk::DispatchLoaderDynamic(instance_, vkGetInstanceProcAddr, device_);
   }
 
   void destroyDevice()
@@ -293,9 +548,16 @@ private:
     }
 
     {
-      const auto allocateInfo = vk::MemoryAllocateInfo()
+      // Buffers bound to the pool may be accessed by device address
+      const auto allocateFlagsInfo = vk::MemoryAllocateFlagsInfo()
+        .setFlags(vk::MemoryAllocateFlagBits::eDeviceAddress);
+
+      auto allocateInfo = vk::MemoryAllocateInfo()
         .setMemoryTypeIndex(deviceIndex_)
         .setAllocationSize(options_.memoryPoolSize);
+      if (bufferDeviceAddressSupported_)
+        allocateInfo.setPNext(&allocateFlagsInfo);
+
       deviceMemory_ = device_.allocateMemory(allocateInfo);
     }
     {
@@ -342,11 +604,37 @@ private:
 
   void createDescriptorPool()
   {
-    constexpr uint32_t maxSets = 256;
-    constexpr uint32_t maxTypeCount = 256;
+    // Pools are chained on demand, starting from a single pool
+    descriptorPoolMaxSets_ = 256;
+    descriptorPools_.push_back(createDescriptorPool(descriptorPoolMaxSets_));
+  }
+
+  void destroyDescriptorPool()
+  {
+    descriptorSets_.clear();
+
+    for (auto descriptorPool : descriptorPools_)
+      device_.destroyDescriptorPool(descriptorPool);
+    descriptorPools_.clear();
+  }
+
+  vk::DescriptorPool createDescriptorPool(uint32_t maxSets)
+  {
+    // Every descriptor type, a few bindings per set on average
+    const uint32_t maxTypeCount = maxSets * 4;
 
     std::vector<vk::DescriptorPoolSize> poolSizes = {
+      {vk::DescriptorType::eSampler, maxTypeCount},
+      {vk::DescriptorType::eCombinedImageSampler, maxTypeCount},
+      {vk::DescriptorType::eSampledImage, maxTypeCount},
+      {vk::DescriptorType::eStorageImage, maxTypeCount},
+      {vk::DescriptorType::eUniformTexelBuffer, maxTypeCount},
+      {vk::DescriptorType::eStorageTexelBuffer, maxTypeCount},
+      {vk::DescriptorType::eUniformBuffer, maxTypeCount},
       {vk::DescriptorType::eStorageBuffer, maxTypeCount},
+      {vk::DescriptorType::eUniformBufferDynamic, maxTypeCount},
+      {vk::DescriptorType::eStorageBufferDynamic, maxTypeCount},
+      {vk::DescriptorType::eInputAttachment, maxTypeCount},
     };
 
     const auto descriptorPoolInfo = vk::DescriptorPoolCreateInfo()
@@ -354,12 +642,56 @@ private:
       .setPoolSizes(poolSizes)
       .setMaxSets(maxSets);
 
-    descriptorPool_ = device_.createDescriptorPool(descriptorPoolInfo);
+    return device_.createDescriptorPool(descriptorPoolInfo);
   }
 
-  void destroyDescriptorPool()
+  std::pair<vk::DescriptorPool, vk::DescriptorSet> allocateDescriptorSet(vk::DescriptorSetLayout layout)
   {
-    device_.destroyDescriptorPool(descriptorPool_);
+    // Sets freed from any pool in the chain are reused before the chain grows, newest and largest pool first
+    for (auto it = descriptorPools_.rbegin(); it != descriptorPools_.rend(); it++)
+    {
+      try
+      {
+        const auto descriptorSetAllocateInfo = vk::DescriptorSetAllocateInfo()
+          .setDescriptorPool(*it)
+          .setSetLayouts(layout);
+
+        return { *it, device_.allocateDescriptorSets(descriptorSetAllocateInfo)[0] };
+      }
+      catch (const vk::OutOfPoolMemoryError&)
+      {
+      }
+      catch (const vk::FragmentedPoolError&)
+      {
+      }
+    }
+
+    // Every pool is exhausted, chain a new one twice as large
+    descriptorPoolMaxSets_ *= 2;
+    const auto descriptorPool = createDescriptorPool(descriptorPoolMaxSets_);
+    descriptorPools_.push_back(descriptorPool);
+
+    const auto descriptorSetAllocateInfo = vk::DescriptorSetAllocateInfo()
+      .setDescriptorPool(descriptorPool)
+      .setSetLayouts(layout);
+
+    return { descriptorPool, device_.allocateDescriptorSets(descriptorSetAllocateInfo)[0] };
+  }
+
+  void freeDescriptorSet(vk::DescriptorPool descriptorPool, vk::DescriptorSet descriptorSet)
+  {
+    device_.freeDescriptorSets(descriptorPool, descriptorSet);
+  }
+
+  void createPipelineCache()
+  {
+    // Shared by pipelines created concurrently, internally synchronized
+    pipelineCache_ = device_.createPipelineCache(vk::PipelineCacheCreateInfo());
+  }
+
+  void destroyPipelineCache()
+  {
+    device_.destroyPipelineCache(pipelineCache_);
   }
 
 private:
@@ -371,6 +703,17 @@ private:
   vk::Device device_;
   vk::Queue queue_;
   uint32_t queueIndex_ = 0;
+  vk::DispatchLoaderDynamic dld_;
+  bool pushDescriptorSupported_ = false;
+  bool bufferDeviceAddressSupported_ = false;
+  bool pipelineStatisticsSupported_ = false;
+  bool calibratedTimestampsSupported_ = false;
+  bool debugUtilsEnabled_ = false;
+  uint32_t minSubgroupSize_ = 0;
+  uint32_t maxSubgroupSize_ = 0;
+
+  // Hot-path counters, indexed by Counter
+  std::array<std::atomic<uint64_t>, static_cast<size_t>(Counter::Count)> counters_{};
 
   // Memory pool
   uint32_t deviceIndex_ = 0;
@@ -385,8 +728,12 @@ private:
   vk::CommandPool transientCommandPool_;
   vk::Fence transferFence_;
 
-  // Descriptor pool
-  vk::DescriptorPool descriptorPool_;
+  // Descriptor pools, a new one is chained when all are exhausted
+  std::vector<vk::DescriptorPool> descriptorPools_;
+  uint32_t descriptorPoolMaxSets_ = 0;
+
+  // Pipeline cache
+  vk::PipelineCache pipelineCache_;
 
   // Compute pipelines
   struct ComputePipeline
@@ -397,8 +744,14 @@ private:
   };
   std::vector<ComputePipeline> computePipelines_;
 
-  // Descriptor sets
-  std::vector<vk::DescriptorSet> descriptorSets_;
+  // Descriptor sets, cached by layout and bound buffers
+  struct CachedDescriptorSet
+  {
+    vk::DescriptorPool descriptorPool;
+    vk::DescriptorSet descriptorSet;
+  };
+  using DescriptorSetKey = std::pair<vk::DescriptorSetLayout, std::vector<vk::Buffer>>;
+  std::map<DescriptorSetKey, CachedDescriptorSet> descriptorSets_;
 };
 
 Engine::Engine(Options options)
@@ -443,21 +796,111 @@ vk::DescriptorPool Engine::descriptorPool() const noexcept
   return impl_->descriptorPool();
 }
 
+bool Engine::pushDescriptorSupported() const noexcept
+{
+  return impl_->pushDescriptorSupported();
+}
+
+bool Engine::bufferDeviceAddressSupported() const noexcept
+{
+  return impl_->bufferDeviceAddressSupported();
+}
+
+bool Engine::pipelineStatisticsSupported() const noexcept
+{
+  return impl_->pipelineStatisticsSupported();
+}
+
+bool Engine::calibratedTimestampsSupported() const noexcept
+{
+  return impl_->calibratedTimestampsSupported();
+}
+
+bool Engine::debugUtilsEnabled() const noexcept
+{
+  return impl_->debugUtilsEnabled();
+}
+
+uint32_t Engine::minSubgroupSize() const noexcept
+{
+  return impl_->minSubgroupSize();
+}
+
+uint32_t Engine::maxSubgroupSize() const noexcept
+{
+  return impl_->maxSubgroupSize();
+}
+
+Engine::Counters Engine::counters() const noexcept
+{
+  return impl_->counters(false);
+}
+
+Engine::Counters Engine::resetCounters() noexcept
+{
+  return impl_->counters(true);
+}
+
+void Engine::addCounter(Counter counter, uint64_t value) noexcept
+{
+  impl_->addCounter(counter, value);
+}
+
 vk::Buffer Engine::createBuffer(vk::DeviceSize size)
 {
   return impl_->createBuffer(size);
 }
 
+vk::DeviceAddress Engine::bufferDeviceAddress(vk::Buffer buffer) const
+{
+  return impl_->bufferDeviceAddress(buffer);
+}
+
+void Engine::destroyBuffer(vk::Buffer buffer)
+{
+  impl_->destroyBuffer(buffer);
+}
+
 void Engine::bindImageMemory(vk::Image image)
 {
   impl_->bindImageMemory(image);
 }
 
+vk::DescriptorSet Engine::descriptorSet(vk::DescriptorSetLayout layout, const std::vector<vk::DescriptorType>& descriptorTypes, const std::vector<vk::DescriptorBufferInfo>& bufferInfos)
+{
+  return impl_->descriptorSet(layout, descriptorTypes, bufferInfos);
+}
+
+void Engine::destroyDescriptorSetLayout(vk::DescriptorSetLayout layout)
+{
+  impl_->destroyDescriptorSetLayout(layout);
+}
+
 vk::ShaderModule Engine::createShaderModule(const std::string& filepath)
 {
   return impl_->createShaderModule(filepath);
 }
 
+vk::PipelineCache Engine::pipelineCache() const noexcept
+{
+  return impl_->pipelineCache();
+}
+
+const vk::DispatchLoaderDynamic& Engine::dispatchLoader() const noexcept
+{
+  return impl_->dispatchLoader();
+}
+
+void Engine::setObjectName(vk::ObjectType objectType, uint64_t handle, const std::string& name)
+{
+  impl_->setObjectName(objectType, handle, name);
+}
+
+std::pair<uint64_t, std::chrono::steady_clock::time_point> Engine::calibrateTimestamps()
+{
+  return impl_->calibrateTimestamps();
+}
+
 vk::Buffer Engine::stagingBuffer() const noexcept
 {
   return impl_->stagingBuffer();
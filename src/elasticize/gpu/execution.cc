@@ -1,13 +1,16 @@
 #include <elasticize/gpu/execution.h>
 
 #include <iostream>
+#include <algorithm>
 
 #include <elasticize/gpu/engine.h>
 #include <elasticize/gpu/compute_shader.h>
 #include <elasticize/gpu/graphics_shader.h>
 #include <elasticize/gpu/descriptor_set.h>
+#include <elasticize/gpu/descriptor_set_layout.h>
 #include <elasticize/gpu/framebuffer.h>
 #include <elasticize/gpu/swapchain.h>
+#include <elasticize/utils/trace.h>
 
 namespace elastic
 {
@@ -18,8 +21,9 @@ class Execution::Impl
 public:
   Impl() = delete;
 
-  Impl(Engine engine)
+  Impl(Engine engine, const Options& options)
     : engine_(engine)
+    , options_(options)
   {
     auto device = engine_.device();
     auto transientCommandPool = engine_.transientCommandPool();
@@ -32,6 +36,21 @@ public:
       .setCommandBufferCount(1);
     commandBuffer_ = device.allocateCommandBuffers(allocateInfo)[0];
 
+    if (options_.profile)
+    {
+      const auto physicalDevice = engine_.physicalDevice();
+      timestampValidBits_ = physicalDevice.getQueueFamilyProperties()[engine_.queueIndex()].timestampValidBits;
+      if (timestampValidBits_ == 0)
+        throw std::runtime_error("Queue does not support timestamp queries");
+
+      timestampPeriod_ = physicalDevice.getProperties().limits.timestampPeriod;
+    }
+
+    if (options_.pipelineStatistics && !engine_.pipelineStatisticsSupported())
+      throw std::runtime_error("Device does not support pipeline statistics queries");
+
+    debugUtils_ = engine_.debugUtilsEnabled();
+
     commandBuffer_.begin(vk::CommandBufferBeginInfo());
   }
 
@@ -40,16 +59,26 @@ public:
     auto device = engine_.device();
     auto transientCommandPool = engine_.transientCommandPool();
 
+    for (auto queryPool : timestampQueryPools_)
+      device.destroyQueryPool(queryPool);
+    for (auto queryPool : statisticsQueryPools_)
+      device.destroyQueryPool(queryPool);
+
     device.freeCommandBuffers(transientCommandPool, commandBuffer_);
     device.destroyFence(fence_);
   }
 
   void toGpu(vk::Buffer buffer, const void* data, vk::DeviceSize size)
   {
+    beginCommand("toGpu");
+
     auto stagingBuffer = engine_.stagingBuffer();
 
     // Copy data to staging buffer
-    engine_.toStagingBuffer(stagingBufferOffsetToGpu_, data, size);
+    {
+      utils::TraceScope trace("toStagingBuffer");
+      engine_.toStagingBuffer(stagingBufferOffsetToGpu_, data, size);
+    }
 
     // Copy command
     auto region = vk::BufferCopy()
@@ -58,12 +87,17 @@ public:
       .setSize(size);
 
     commandBuffer_.copyBuffer(stagingBuffer, buffer, region);
+    engine_.addCounter(Engine::Counter::BytesUploaded, size);
 
     stagingBufferOffsetToGpu_ += size;
+
+    endCommand();
   }
 
   void fromGpu(vk::Buffer buffer, void* data, vk::DeviceSize size)
   {
+    beginCommand("fromGpu");
+
     auto stagingBuffer = engine_.stagingBuffer();
 
     // Record memcpy targets
@@ -75,25 +109,97 @@ public:
       .setSize(size);
 
     commandBuffer_.copyBuffer(buffer, stagingBuffer, region);
+    engine_.addCounter(Engine::Counter::BytesReadBack, size);
 
     stagingBufferOffsetFromGpu_ += size;
+
+    endCommand();
   }
 
-  void copy(vk::Buffer srcBuffer, vk::Buffer dstBuffer, vk::DeviceSize size)
+  void copy(vk::Buffer srcBuffer, vk::Buffer dstBuffer, vk::DeviceSize size, vk::DeviceSize srcOffset, vk::DeviceSize dstOffset)
   {
+    beginCommand("copy");
+
     auto region = vk::BufferCopy()
-      .setSrcOffset(0)
-      .setDstOffset(0)
+      .setSrcOffset(srcOffset)
+      .setDstOffset(dstOffset)
       .setSize(size);
     commandBuffer_.copyBuffer(srcBuffer, dstBuffer, region);
+    engine_.addCounter(Engine::Counter::BytesCopied, size);
+
+    endCommand();
   }
 
-  void runComputeShader(ComputeShader computeShader, DescriptorSet descriptorSet, uint32_t groupCountX, const void* pushConstants, uint32_t size)
+  void fill(vk::Buffer buffer, vk::DeviceSize size, uint32_t value)
   {
-    commandBuffer_.bindDescriptorSets(vk::PipelineBindPoint::eCompute, computeShader.pipelineLayout(), 0u, static_cast<vk::DescriptorSet>(descriptorSet), {});
+    beginCommand("fill");
+
+    commandBuffer_.fillBuffer(buffer, 0, size, value);
+
+    endCommand();
+  }
+
+  void runComputeShader(ComputeShader computeShader, DescriptorSet descriptorSet, const std::vector<uint32_t>& dynamicOffsets, uint32_t groupCountX, const void* pushConstants, uint32_t size)
+  {
+    beginCommand(computeShader.name());
+
+    commandBuffer_.bindDescriptorSets(vk::PipelineBindPoint::eCompute, computeShader.pipelineLayout(), 0u, static_cast<vk::DescriptorSet>(descriptorSet), dynamicOffsets);
     commandBuffer_.bindPipeline(vk::PipelineBindPoint::eCompute, computeShader.pipeline());
     commandBuffer_.pushConstants(computeShader.pipelineLayout(), vk::ShaderStageFlagBits::eCompute, 0u, size, pushConstants);
     commandBuffer_.dispatch(groupCountX, 1, 1);
+    engine_.addCounter(Engine::Counter::PipelineBinds);
+    engine_.addCounter(Engine::Counter::Dispatches);
+
+    endCommand();
+  }
+
+  void runComputeShader(ComputeShader computeShader, const std::vector<vk::DescriptorBufferInfo>& bufferInfos, uint32_t groupCountX, const void* pushConstants, uint32_t size)
+  {
+    beginCommand(computeShader.name());
+
+    const auto descriptorSetLayout = computeShader.descriptorSetLayout();
+    const auto& descriptorTypes = descriptorSetLayout.descriptorTypes();
+
+    if (descriptorSetLayout.pushDescriptor())
+    {
+      std::vector<vk::WriteDescriptorSet> writes(bufferInfos.size());
+      for (int i = 0; i < bufferInfos.size(); i++)
+      {
+        writes[i]
+          .setDstBinding(i)
+          .setDescriptorType(descriptorTypes[i])
+          .setDescriptorCount(1)
+          .setBufferInfo(bufferInfos[i]);
+      }
+
+      commandBuffer_.pushDescriptorSetKHR(vk::PipelineBindPoint::eCompute, computeShader.pipelineLayout(), 0u, writes, engine_.dispatchLoader());
+    }
+    else
+    {
+      const auto descriptorSet = engine_.descriptorSet(descriptorSetLayout, descriptorTypes, bufferInfos);
+      commandBuffer_.bindDescriptorSets(vk::PipelineBindPoint::eCompute, computeShader.pipelineLayout(), 0u, descriptorSet, {});
+    }
+
+    commandBuffer_.bindPipeline(vk::PipelineBindPoint::eCompute, computeShader.pipeline());
+    commandBuffer_.pushConstants(computeShader.pipelineLayout(), vk::ShaderStageFlagBits::eCompute, 0u, size, pushConstants);
+    commandBuffer_.dispatch(groupCountX, 1, 1);
+    engine_.addCounter(Engine::Counter::PipelineBinds);
+    engine_.addCounter(Engine::Counter::Dispatches);
+
+    endCommand();
+  }
+
+  void runComputeShader(ComputeShader computeShader, uint32_t groupCountX, const void* pushConstants, uint32_t size)
+  {
+    beginCommand(computeShader.name());
+
+    commandBuffer_.bindPipeline(vk::PipelineBindPoint::eCompute, computeShader.pipeline());
+    commandBuffer_.pushConstants(computeShader.pipelineLayout(), vk::ShaderStageFlagBits::eCompute, 0u, size, pushConstants);
+    commandBuffer_.dispatch(groupCountX, 1, 1);
+    engine_.addCounter(Engine::Counter::PipelineBinds);
+    engine_.addCounter(Engine::Counter::Dispatches);
+
+    endCommand();
   }
 
   void barrier()
@@ -107,10 +213,13 @@ public:
       vk::PipelineStageFlagBits::eComputeShader | vk::PipelineStageFlagBits::eTransfer,
       {},
       memoryBarrier, {}, {});
+    engine_.addCounter(Engine::Counter::Barriers);
   }
 
   void draw(GraphicsShader graphicsShader, DescriptorSet descriptorSet, Framebuffer framebuffer, vk::Buffer vertexBuffer, vk::Buffer indexBuffer, uint32_t indexCount)
   {
+    beginCommand("draw");
+
     commandBuffer_.bindPipeline(vk::PipelineBindPoint::eGraphics, graphicsShader.pipeline());
 
     const auto width = framebuffer.width();
@@ -152,9 +261,17 @@ public:
     commandBuffer_.bindVertexBuffers(0, { vertexBuffer }, { 0 });
     commandBuffer_.bindIndexBuffer(indexBuffer, 0, vk::IndexType::eUint32);
     commandBuffer_.drawIndexed(indexCount, 1, 0, 0, 0);
+    engine_.addCounter(Engine::Counter::PipelineBinds);
+    engine_.addCounter(Engine::Counter::Draws);
 
     commandBuffer_.endRenderPass();
 
+    endCommand();
+  }
+
+  void name(const std::string& name)
+  {
+    pendingName_ = name;
   }
 
   void end()
@@ -167,18 +284,37 @@ public:
     auto device = engine_.device();
     auto queue = engine_.queue();
 
-    const auto submit = vk::SubmitInfo().setCommandBuffers(commandBuffer_);
-    queue.submit(submit, fence_);
-
-    device.waitForFences(fence_, true, UINT64_MAX);
+    submitTime_ = utils::Tracer::Clock::now();
+    {
+      utils::TraceScope trace("submit");
+      const auto submit = vk::SubmitInfo().setCommandBuffers(commandBuffer_);
+      queue.submit(submit, fence_);
+    }
+    engine_.addCounter(Engine::Counter::Submits);
+
+    {
+      utils::TraceScope trace("waitForFences");
+      const auto waitBegin = utils::Tracer::Clock::now();
+      device.waitForFences(fence_, true, UINT64_MAX);
+      const auto waitTime = std::chrono::duration_cast<std::chrono::nanoseconds>(utils::Tracer::Clock::now() - waitBegin);
+      engine_.addCounter(Engine::Counter::FenceWaitNanoseconds, static_cast<uint64_t>(waitTime.count()));
+    }
     device.resetFences(fence_);
     commandBuffer_.reset();
 
     // From staging buffer to actual buffers
-    for (auto fromGpuRange : fromGpus_)
-      engine_.fromStagingBuffer(fromGpuRange.target, fromGpuRange.stagingBufferOffset, fromGpuRange.size);
+    {
+      utils::TraceScope trace("fromStagingBuffer");
+      for (auto fromGpuRange : fromGpus_)
+        engine_.fromStagingBuffer(fromGpuRange.target, fromGpuRange.stagingBufferOffset, fromGpuRange.size);
+    }
+
+    if (options_.profile || options_.pipelineStatistics)
+      readQueryResults();
   }
 
+  const auto& report() const noexcept { return report_; }
+
   void present(vk::Semaphore imageAvailableSemaphore, vk::Semaphore renderFinishedSemaphore, vk::Fence renderFinishedFence, Swapchain swapchain, uint32_t imageIndex)
   {
     auto queue = engine_.queue();
@@ -196,6 +332,7 @@ public:
       .setCommandBuffers(commandBuffer_)
       .setSignalSemaphores(renderFinishedSemaphore);
     queue.submit(submitInfo, renderFinishedFence);
+    engine_.addCounter(Engine::Counter::Submits);
 
     // Present
     std::vector<vk::SwapchainKHR> swapchains = {
@@ -209,7 +346,196 @@ public:
   }
 
 private:
+  void beginCommand(const std::string& defaultName)
+  {
+    CommandQuery command;
+    command.name = pendingName_.empty() ? defaultName : pendingName_;
+    pendingName_.clear();
+
+    if (options_.profile)
+    {
+      command.timestampQuery = allocateTimestampQueries();
+      writeTimestamp(vk::PipelineStageFlagBits::eTopOfPipe, command.timestampQuery);
+    }
+
+    if (debugUtils_)
+      commandBuffer_.beginDebugUtilsLabelEXT(vk::DebugUtilsLabelEXT().setPLabelName(command.name.c_str()), engine_.dispatchLoader());
+
+    if (options_.pipelineStatistics)
+    {
+      command.statisticsQuery = allocateStatisticsQuery();
+      commandBuffer_.beginQuery(statisticsQueryPools_[command.statisticsQuery / queriesPerPool], command.statisticsQuery % queriesPerPool, {});
+    }
+
+    commands_.push_back(std::move(command));
+  }
+
+  void endCommand()
+  {
+    const auto& command = commands_.back();
+
+    if (options_.pipelineStatistics)
+      commandBuffer_.endQuery(statisticsQueryPools_[command.statisticsQuery / queriesPerPool], command.statisticsQuery % queriesPerPool);
+
+    if (debugUtils_)
+      commandBuffer_.endDebugUtilsLabelEXT(engine_.dispatchLoader());
+
+    if (options_.profile)
+      writeTimestamp(vk::PipelineStageFlagBits::eBottomOfPipe, command.timestampQuery + 1);
+  }
+
+  // Begin and end timestamps of a command are consecutive queries in the same pool
+  uint32_t allocateTimestampQueries()
+  {
+    if (timestampQueryCount_ % queriesPerPool == 0)
+    {
+      const auto queryPoolInfo = vk::QueryPoolCreateInfo()
+        .setQueryType(vk::QueryType::eTimestamp)
+        .setQueryCount(queriesPerPool);
+      timestampQueryPools_.push_back(engine_.device().createQueryPool(queryPoolInfo));
+
+      // Recorded outside render passes, reset on every submission
+      commandBuffer_.resetQueryPool(timestampQueryPools_.back(), 0, queriesPerPool);
+    }
+
+    const auto query = timestampQueryCount_;
+    timestampQueryCount_ += 2;
+    return query;
+  }
+
+  void writeTimestamp(vk::PipelineStageFlagBits stage, uint32_t query)
+  {
+    commandBuffer_.writeTimestamp(stage, timestampQueryPools_[query / queriesPerPool], query % queriesPerPool);
+  }
+
+  uint32_t allocateStatisticsQuery()
+  {
+    if (statisticsQueryCount_ % queriesPerPool == 0)
+    {
+      const auto queryPoolInfo = vk::QueryPoolCreateInfo()
+        .setQueryType(vk::QueryType::ePipelineStatistics)
+        .setQueryCount(queriesPerPool)
+        .setPipelineStatistics(statisticsFlags);
+      statisticsQueryPools_.push_back(engine_.device().createQueryPool(queryPoolInfo));
+
+      commandBuffer_.resetQueryPool(statisticsQueryPools_.back(), 0, queriesPerPool);
+    }
+
+    return statisticsQueryCount_++;
+  }
+
+  void readQueryResults()
+  {
+    auto device = engine_.device();
+
+    // Counters are written in bit order of statisticsFlags
+    constexpr uint32_t statisticsCount = 7;
+    std::vector<uint64_t> statistics(static_cast<size_t>(statisticsQueryCount_) * statisticsCount);
+    for (uint32_t i = 0; i < statisticsQueryPools_.size(); i++)
+    {
+      const auto first = i * queriesPerPool;
+      const auto count = std::min(queriesPerPool, statisticsQueryCount_ - first);
+      const auto stride = sizeof(uint64_t) * statisticsCount;
+      (void)device.getQueryPoolResults(statisticsQueryPools_[i], 0, count,
+        stride * count, statistics.data() + static_cast<size_t>(first) * statisticsCount, stride,
+        vk::QueryResultFlagBits::e64 | vk::QueryResultFlagBits::eWait);
+    }
+
+    std::vector<uint64_t> timestamps(timestampQueryCount_);
+    for (uint32_t i = 0; i < timestampQueryPools_.size(); i++)
+    {
+      const auto first = i * queriesPerPool;
+      const auto count = std::min(queriesPerPool, timestampQueryCount_ - first);
+      (void)device.getQueryPoolResults(timestampQueryPools_[i], 0, count,
+        sizeof(uint64_t) * count, timestamps.data() + first, sizeof(uint64_t),
+        vk::QueryResultFlagBits::e64 | vk::QueryResultFlagBits::eWait);
+    }
+
+    const uint64_t mask = timestampValidBits_ >= 64 ? ~0ull : ((1ull << timestampValidBits_) - 1);
+
+    report_.clear();
+    for (const auto& command : commands_)
+    {
+      CommandReport commandReport;
+      commandReport.name = command.name;
+
+      if (options_.profile)
+      {
+        const auto begin = timestamps[command.timestampQuery] & mask;
+        const auto end = timestamps[command.timestampQuery + 1] & mask;
+        commandReport.elapsed = static_cast<double>((end - begin) & mask) * timestampPeriod_ * 1e-6;
+      }
+
+      if (options_.pipelineStatistics)
+      {
+        const auto* values = statistics.data() + static_cast<size_t>(command.statisticsQuery) * statisticsCount;
+        auto& commandStatistics = commandReport.statistics;
+        commandStatistics.inputAssemblyVertices = values[0];
+        commandStatistics.inputAssemblyPrimitives = values[1];
+        commandStatistics.vertexShaderInvocations = values[2];
+        commandStatistics.clippingInvocations = values[3];
+        commandStatistics.clippingPrimitives = values[4];
+        commandStatistics.fragmentShaderInvocations = values[5];
+        commandStatistics.computeShaderInvocations = values[6];
+      }
+
+      report_.push_back(std::move(commandReport));
+    }
+
+    if (options_.profile && utils::Tracer::global().enabled())
+      traceCommands(timestamps, mask);
+  }
+
+  // Places GPU command zones on the tracer timeline
+  void traceCommands(const std::vector<uint64_t>& timestamps, uint64_t mask)
+  {
+    if (commands_.empty())
+      return;
+
+    // Anchor a device timestamp to host time, calibrated if possible, otherwise the first command starts at submit
+    uint64_t anchorTimestamp = timestamps[commands_.front().timestampQuery] & mask;
+    auto anchorTime = submitTime_;
+    if (engine_.calibratedTimestampsSupported())
+    {
+      const auto calibration = engine_.calibrateTimestamps();
+      anchorTimestamp = calibration.first & mask;
+      anchorTime = calibration.second;
+    }
+
+    const auto toHostTime = [&](uint64_t timestamp)
+    {
+      // Signed distance from the anchor, wrapping within the valid bits
+      auto ticks = static_cast<int64_t>((timestamp - anchorTimestamp) & mask);
+      if (mask != ~0ull && static_cast<uint64_t>(ticks) > (mask >> 1))
+        ticks -= static_cast<int64_t>(mask) + 1;
+
+      const auto nanoseconds = std::chrono::duration<double, std::nano>(static_cast<double>(ticks) * timestampPeriod_);
+      return anchorTime + std::chrono::duration_cast<utils::Tracer::Clock::duration>(nanoseconds);
+    };
+
+    auto& tracer = utils::Tracer::global();
+    for (const auto& command : commands_)
+    {
+      const auto begin = toHostTime(timestamps[command.timestampQuery] & mask);
+      const auto end = toHostTime(timestamps[command.timestampQuery + 1] & mask);
+      tracer.zone(command.name, utils::Tracer::gpuTrack, begin, end);
+    }
+  }
+
+private:
+  static constexpr uint32_t queriesPerPool = 256;
+  static constexpr vk::QueryPipelineStatisticFlags statisticsFlags =
+    vk::QueryPipelineStatisticFlagBits::eInputAssemblyVertices |
+    vk::QueryPipelineStatisticFlagBits::eInputAssemblyPrimitives |
+    vk::QueryPipelineStatisticFlagBits::eVertexShaderInvocations |
+    vk::QueryPipelineStatisticFlagBits::eClippingInvocations |
+    vk::QueryPipelineStatisticFlagBits::eClippingPrimitives |
+    vk::QueryPipelineStatisticFlagBits::eFragmentShaderInvocations |
+    vk::QueryPipelineStatisticFlagBits::eComputeShaderInvocations;
+
   Engine engine_;
+  Options options_;
+  bool debugUtils_ = false;
 
   vk::Fence fence_;
   vk::CommandBuffer commandBuffer_;
@@ -223,10 +549,33 @@ private:
   };
   std::vector<FromGpu> fromGpus_;
   vk::DeviceSize stagingBufferOffsetFromGpu_ = 0;
+
+  // Profiling
+  struct CommandQuery
+  {
+    std::string name;
+    uint32_t timestampQuery = 0;
+    uint32_t statisticsQuery = 0;
+  };
+  std::string pendingName_;
+  std::vector<CommandQuery> commands_;
+  std::vector<vk::QueryPool> timestampQueryPools_;
+  uint32_t timestampQueryCount_ = 0;
+  uint32_t timestampValidBits_ = 0;
+  float timestampPeriod_ = 1.f;
+  std::vector<vk::QueryPool> statisticsQueryPools_;
+  uint32_t statisticsQueryCount_ = 0;
+  utils::Tracer::TimePoint submitTime_;
+  std::vector<CommandReport> report_;
 };
 
 Execution::Execution(Engine engine)
-  : impl_(std::make_shared<Impl>(engine))
+  : impl_(std::make_shared<Impl>(engine, Options()))
+{
+}
+
+Execution::Execution(Engine engine, const Options& options)
+  : impl_(std::make_shared<Impl>(engine, options))
 {
 }
 
@@ -244,15 +593,43 @@ Execution& Execution::fromGpu(vk::Buffer buffer, void* data, vk::DeviceSize size
   return *this;
 }
 
-Execution& Execution::copy(vk::Buffer srcBuffer, vk::Buffer dstBuffer, vk::DeviceSize size)
+Execution& Execution::copy(vk::Buffer srcBuffer, vk::Buffer dstBuffer, vk::DeviceSize size, vk::DeviceSize srcOffset, vk::DeviceSize dstOffset)
 {
-  impl_->copy(srcBuffer, dstBuffer, size);
+  impl_->copy(srcBuffer, dstBuffer, size, srcOffset, dstOffset);
+  return *this;
+}
+
+Execution& Execution::fill(vk::Buffer buffer, vk::DeviceSize size, uint32_t value)
+{
+  impl_->fill(buffer, size, value);
   return *this;
 }
 
 Execution& Execution::runComputeShader(ComputeShader computeShader, DescriptorSet descriptorSet, uint32_t groupCountX, const void* pushConstants, uint32_t size)
 {
-  impl_->runComputeShader(computeShader, descriptorSet, groupCountX, pushConstants, size);
+  impl_->runComputeShader(computeShader, descriptorSet, {}, groupCountX, pushConstants, size);
+  return *this;
+}
+
+Execution& Execution::runComputeShader(ComputeShader computeShader, DescriptorSet descriptorSet, const std::vector<uint32_t>& dynamicOffsets, uint32_t groupCountX, const void* pushConstants, uint32_t size)
+{
+  impl_->runComputeShader(computeShader, descriptorSet, dynamicOffsets, groupCountX, pushConstants, size);
+  return *this;
+}
+
+Execution& Execution::runComputeShader(ComputeShader computeShader, const std::vector<DescriptorSet::BufferProxy>& buffers, uint32_t groupCountX, const void* pushConstants, uint32_t size)
+{
+  std::vector<vk::DescriptorBufferInfo> bufferInfos;
+  for (const auto& buffer : buffers)
+    bufferInfos.push_back(buffer.bufferInfo());
+
+  impl_->runComputeShader(computeShader, bufferInfos, groupCountX, pushConstants, size);
+  return *this;
+}
+
+Execution& Execution::runComputeShader(ComputeShader computeShader, uint32_t groupCountX, const void* pushConstants, uint32_t size)
+{
+  impl_->runComputeShader(computeShader, groupCountX, pushConstants, size);
   return *this;
 }
 
@@ -268,6 +645,12 @@ Execution& Execution::draw(GraphicsShader graphicsShader, DescriptorSet descript
   return *this;
 }
 
+Execution& Execution::name(const std::string& name)
+{
+  impl_->name(name);
+  return *this;
+}
+
 Execution& Execution::end()
 {
   impl_->end();
@@ -279,6 +662,11 @@ void Execution::run()
   impl_->run();
 }
 
+const std::vector<Execution::CommandReport>& Execution::report() const noexcept
+{
+  return impl_->report();
+}
+
 void Execution::present(vk::Semaphore imageAvailableSemaphore, vk::Semaphore renderFinishedSemaphore, vk::Fence renderFinishedFence, Swapchain swapchain, uint32_t imageIndex)
 {
   impl_->present(imageAvailableSemaphore, renderFinishedSemaphore, renderFinishedFence, swapchain, imageIndex);
@@ -0,0 +1,80 @@
+#include <elasticize/gpu/gather.h>
+
+#include <stdexcept>
+
+#include <elasticize/gpu/engine.h>
+#include <elasticize/gpu/execution.h>
+#include <elasticize/gpu/compute_shader.h>
+#include <elasticize/gpu/descriptor_set_layout.h>
+
+namespace elastic
+{
+namespace gpu
+{
+namespace
+{
+constexpr uint32_t blockSize = 256;
+
+// Layout of GatherInfo in shader/utils/gather.comp, buffer references are 8-byte aligned
+struct GatherInfo
+{
+  vk::DeviceAddress src;
+  vk::DeviceAddress indices;
+  vk::DeviceAddress dst;
+  uint32_t count;
+};
+}
+
+class Gather::Impl
+{
+public:
+  Impl() = delete;
+
+  // No bindings, and the default push constant range holds the addresses
+  Impl(Engine engine, const std::string& shaderDirpath)
+    : descriptorSetLayout_(engine, 0u)
+    , gatherShader_(engine, ComputeShader::CreateInfo{ shaderDirpath + "\\utils\\gather.comp.spv", descriptorSetLayout_, {} })
+  {
+  }
+
+  ~Impl() = default;
+
+  void gather(Execution& execution, vk::DeviceAddress src, vk::DeviceAddress indices, vk::DeviceAddress dst, uint32_t count)
+  {
+    if (count == 0)
+      return;
+
+    const GatherInfo gatherInfo{ src, indices, dst, count };
+    execution
+      .name("gather")
+      .runComputeShader(gatherShader_, (count + blockSize - 1) / blockSize, gatherInfo)
+      .barrier();
+  }
+
+private:
+  DescriptorSetLayout descriptorSetLayout_;
+  ComputeShader gatherShader_;
+};
+
+bool Gather::supported(Engine engine)
+{
+  return engine.bufferDeviceAddressSupported();
+}
+
+Gather::Gather(Engine engine, const std::string& shaderDirpath)
+{
+  // Checked before the pipeline is created, its shader uses physical storage buffer pointers
+  if (!supported(engine))
+    throw std::runtime_error("Gather needs buffer device addresses");
+
+  impl_ = std::make_shared<Impl>(engine, shaderDirpath);
+}
+
+Gather::~Gather() = default;
+
+void Gather::gather(Execution& execution, vk::DeviceAddress src, vk::DeviceAddress indices, vk::DeviceAddress dst, uint32_t count)
+{
+  impl_->gather(execution, src, indices, dst, count);
+}
+}
+}
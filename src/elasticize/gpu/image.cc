@@ -74,6 +74,12 @@ public:
 
   auto imageView() const noexcept { return imageView_; }
 
+  void setName(const std::string& name)
+  {
+    engine_.setObjectName(image_, name);
+    engine_.setObjectName(imageView_, name);
+  }
+
 private:
   Engine engine_;
   bool created_;
@@ -97,5 +103,7 @@ Image::~Image() = default;
 Image::operator vk::Image() const noexcept { return *impl_; }
 
 vk::ImageView Image::imageView() const noexcept { return impl_->imageView(); }
+
+void Image::setName(const std::string& name) { impl_->setName(name); }
 }
 }
@@ -0,0 +1,733 @@
+#include <elasticize/gpu/radix_sort.h>
+
+#include <algorithm>
+#include <optional>
+#include <stdexcept>
+
+#include <elasticize/gpu/engine.h>
+#include <elasticize/gpu/execution.h>
+#include <elasticize/gpu/compute_shader.h>
+#include <elasticize/gpu/descriptor_set_layout.h>
+#include <elasticize/gpu/tuner.h>
+#include <elasticize/gpu/validator.h>
+
+namespace elastic
+{
+namespace gpu
+{
+namespace
+{
+// count and distribute use one invocation per radix digit, so their block size is fixed
+constexpr uint32_t blockSize = 256;
+constexpr uint32_t radixBits = 8;
+
+// Keys ranked per invocation by distribute_multisplit.comp
+constexpr uint32_t multisplitItemsPerThread = 8;
+
+// Scan block sizes tune() chooses from, the smallest one needs the most scratch
+const std::vector<uint32_t> scanBlockSizes = { 64, 128, 256, 512, 1024 };
+
+// Keys per onesweep workgroup, BLOCK_SIZE * ITEMS_PER_THREAD in shader/radix_sort/onesweep_*.comp
+constexpr uint32_t onesweepTileSize = 256 * 16;
+
+// Per-pass digit offsets followed by per-pass partition counters
+constexpr uint32_t onesweepGlobalSize = 4 * 256 + 4;
+
+// Elements per workgroup of shader/radix_sort/block_sort.comp on devices with the shared memory for them
+constexpr uint32_t smallSortTileSize = 2048;
+
+// Outputs per invocation of shader/radix_sort/merge.comp, whose tiles of blockSize * mergeItemsPerThread
+// are no larger than the smallest tileSize_ so each lies within one merged run
+constexpr uint32_t mergeItemsPerThread = 4;
+
+// Small sort thresholds tune() chooses from, 0 disables the path
+const std::vector<uint32_t> blockSortThresholds = { 0, 256, 512, 1024, 2048 };
+const std::vector<uint32_t> mergeSortThresholds = { 0, 1u << 12, 1u << 14, 1u << 16, 1u << 18 };
+
+struct SmallSortInfo
+{
+  uint32_t arraySize;
+  uint32_t sortSize;
+};
+
+struct MergeInfo
+{
+  uint32_t arraySize;
+  uint32_t width;
+};
+
+struct SortInfo
+{
+  uint32_t arraySize;
+  int32_t bitOffset;
+  uint32_t scanOffset;
+};
+
+// DistributeInfo in shader/radix_sort/distribute.glsl
+struct DistributeInfo
+{
+  uint32_t arraySize;
+  int32_t bitOffset;
+  int32_t passEnd; // bit offset past the last pass, where counting for a next pass stops
+};
+
+struct OnesweepHistogramInfo
+{
+  uint32_t arraySize;
+  uint32_t passCount;
+};
+
+struct OnesweepScatterInfo
+{
+  uint32_t arraySize;
+  int32_t bitOffset;
+  uint32_t pass;
+};
+
+// block_sort.comp keeps a key, value and index per element in shared memory
+uint32_t blockSortTileSize(Engine engine)
+{
+  const auto& limits = engine.physicalDevice().getProperties().limits;
+  return limits.maxComputeSharedMemorySize >= 3 * sizeof(uint32_t) * smallSortTileSize ? smallSortTileSize : smallSortTileSize / 2;
+}
+
+// The scan needs whole subgroups and a single subgroup to scan the subgroup totals, see shader/radix_sort/scan_forward.comp
+bool scanBlockSizeSupported(Engine engine, uint32_t scanBlockSize)
+{
+  const auto deviceProperties = engine.physicalDevice().getProperties2<vk::PhysicalDeviceProperties2, vk::PhysicalDeviceSubgroupProperties>();
+  const auto& limits = deviceProperties.get<vk::PhysicalDeviceProperties2>().properties.limits;
+  const auto subgroupSize = deviceProperties.get<vk::PhysicalDeviceSubgroupProperties>().subgroupSize;
+
+  return scanBlockSize % subgroupSize == 0 && scanBlockSize <= subgroupSize * subgroupSize &&
+    scanBlockSize <= limits.maxComputeWorkGroupSize[0] && scanBlockSize <= limits.maxComputeWorkGroupInvocations;
+}
+
+// Multi-level scan scratch, laid out level after level
+uint32_t counterSize(uint32_t count, uint32_t scanBlockSize)
+{
+  const auto alignedSize = (count + blockSize - 1) / blockSize * blockSize;
+  uint32_t size = 0;
+  uint32_t simdSize = alignedSize;
+  do
+  {
+    size += simdSize;
+    simdSize = (simdSize + scanBlockSize - 1) / scanBlockSize;
+  } while (simdSize > 1);
+  return size;
+}
+
+// Digit counts of every tile, the first level of the counter
+uint32_t histogramSize(uint32_t count)
+{
+  return (count + blockSize - 1) / blockSize * blockSize;
+}
+
+// One status word per digit and partition of a pass
+uint32_t onesweepStatusSize(uint32_t count)
+{
+  return (count + onesweepTileSize - 1) / onesweepTileSize * 256;
+}
+}
+
+class RadixSort::Impl
+{
+private:
+  struct ScanShaders
+  {
+    uint32_t blockSize;
+    ComputeShader forward;
+    ComputeShader backward;
+  };
+
+  // count and distribute specialized for an element layout
+  struct SortShaders
+  {
+    uint32_t elementWords;
+    Validator::KeyType keyType;
+    bool permutation;
+    ComputeShader count;
+    ComputeShader distribute;
+    ComputeShader copyBack;
+  };
+
+public:
+  static constexpr Layout keyValueLayout{ sizeof(KeyValue) / sizeof(uint32_t), Validator::KeyType::Uint };
+
+public:
+  Impl() = delete;
+
+  Impl(Engine engine, const std::string& shaderDirpath, const Options& options)
+    : engine_(engine)
+    , shaderDirpath_(shaderDirpath)
+    , maxCount_(options.maxCount)
+    , algorithm_(options.algorithm)
+    , skipUniformPasses_(options.skipUniformPasses)
+    , tileSize_(blockSortTileSize(engine))
+    , blockSortThreshold_(std::min(options.blockSortThreshold, tileSize_))
+    , mergeSortThreshold_(options.mergeSortThreshold)
+    , itemsPerThread_(options.multisplit && subgroupRankingSupported(engine) ? multisplitItemsPerThread : 1)
+    , descriptorSetLayout_(engine, std::vector<vk::DescriptorType>(7, vk::DescriptorType::eStorageBuffer), true)
+    , outBuffer_(engine, 2 * static_cast<uint64_t>(std::max(maxCount_, 1u))) // KeyValue or 64-bit key per element
+    , counterBuffer_(engine, counterSize(std::max(maxCount_, 1u), scanBlockSizes.front())) // 1D index of [workgroupID][key]
+    , nextCounterBuffer_(engine, histogramSize(std::max(maxCount_, 1u)))
+    , controlBuffer_(engine, 2)
+    , scan_(createScanShaders(options.scanBlockSize))
+    , smallSortLayout_(engine, std::vector<vk::DescriptorType>(2, vk::DescriptorType::eStorageBuffer), true)
+    , blockSortShader_(engine, ComputeShader::CreateInfo{ shaderDirpath + "\\radix_sort\\block_sort.comp.spv", smallSortLayout_, {}, { tileSize_ } })
+    , mergeShader_(engine, ComputeShader::CreateInfo{ shaderDirpath + "\\radix_sort\\merge.comp.spv", smallSortLayout_, {} })
+  {
+    outBuffer_.setName("radix_sort_out");
+    counterBuffer_.setName("radix_sort_counter");
+    nextCounterBuffer_.setName("radix_sort_next_counter");
+    controlBuffer_.setName("radix_sort_control");
+
+    sortShaders(keyValueLayout, false);
+
+    if (options.permutation)
+    {
+      valueBuffer_.emplace(engine, std::max(maxCount_, 1u));
+      valueBuffer_->setName("radix_sort_values");
+      iotaShader_.emplace(engine, ComputeShader::CreateInfo{ shaderDirpath + "\\radix_sort\\iota.comp.spv", descriptorSetLayout_, {} });
+    }
+
+    if (algorithm_ == Algorithm::Onesweep)
+      createOnesweep();
+
+    if (options.validate)
+      validator_.emplace(engine, shaderDirpath);
+  }
+
+  ~Impl() = default;
+
+  auto maxCount() const noexcept { return maxCount_; }
+  auto scanBlockSize() const noexcept { return scan_.blockSize; }
+  auto multisplit() const noexcept { return itemsPerThread_ > 1; }
+
+  void sort(Execution& execution, const Layout& layout, DescriptorSet::BufferProxy elements, std::optional<DescriptorSet::BufferProxy> permutation, uint32_t count, uint32_t keyBits)
+  {
+    if (permutation && !valueBuffer_)
+      throw std::runtime_error("RadixSort was not created with Options::permutation");
+
+    if (validator_)
+      validator_->begin(execution).checksum(execution, elements, count, layout.elementWords, 0);
+
+    recordSort(execution, layout, elements, permutation, count, keyBits);
+
+    if (validator_)
+    {
+      validator_
+        ->isSorted(execution, elements, count, layout.elementWords, layout.keyType)
+        .checksum(execution, elements, count, layout.elementWords, 1)
+        .end(execution);
+    }
+  }
+
+  void tune(Tuner& tuner, const Buffer<KeyValue>& keyValues, uint32_t count, uint32_t keyBits)
+  {
+    std::vector<Tuner::Variant> candidates;
+    for (auto candidate : scanBlockSizes)
+    {
+      if (scanBlockSizeSupported(engine_, candidate))
+        candidates.push_back({ candidate });
+    }
+
+    Execution::Options profileOptions;
+    profileOptions.profile = true;
+
+    // Pipelines of each candidate are created on its first measurement
+    std::vector<ScanShaders> candidateShaders;
+    const auto winner = tuner.tune("radix_sort_scan" + multipassTuningSuffix(), candidates, [&](const Tuner::Variant& variant)
+      {
+        auto it = std::find_if(candidateShaders.begin(), candidateShaders.end(), [&variant](const auto& shaders) { return shaders.blockSize == variant[0]; });
+        if (it == candidateShaders.end())
+          it = candidateShaders.insert(candidateShaders.end(), createScanShaders(variant[0]));
+
+        Execution(engine_).toGpu(keyValues, count).run();
+
+        Execution execution(engine_, profileOptions);
+        recordMultipass(execution, keyValueLayout, keyValues, std::nullopt, count, keyBits, *it);
+        execution.end();
+        execution.run();
+        return Tuner::gpuElapsed(execution);
+      }, largeSortShaderFilepaths(false));
+
+    if (winner[0] != scan_.blockSize)
+      scan_ = createScanShaders(winner[0]);
+
+    // Small sort thresholds from the crossovers with the radix sort, measured over sorts of every power of two
+    // up to past the largest merge threshold, each weighted per key so small sorts count as much as large ones
+    std::vector<uint32_t> sizes;
+    for (uint32_t size = blockSortThresholds[1]; size <= std::min(count, 2 * mergeSortThresholds.back()); size *= 2)
+      sizes.push_back(size);
+    if (sizes.empty())
+      return;
+
+    std::vector<Tuner::Variant> thresholdCandidates;
+    for (auto blockSortThreshold : blockSortThresholds)
+    {
+      if (blockSortThreshold <= tileSize_)
+      {
+        for (auto mergeSortThreshold : mergeSortThresholds)
+          thresholdCandidates.push_back({ blockSortThreshold, mergeSortThreshold });
+      }
+    }
+
+    // Crossovers depend on the large sort path they were measured against
+    const auto onesweep = algorithm_ == Algorithm::Onesweep;
+    auto shaderFilepaths = largeSortShaderFilepaths(onesweep);
+    shaderFilepaths.push_back(shaderDirpath_ + "\\radix_sort\\block_sort.comp.spv");
+    shaderFilepaths.push_back(shaderDirpath_ + "\\radix_sort\\merge.comp.spv");
+
+    const auto thresholds = tuner.tune("radix_sort_small" + (onesweep ? std::string("_onesweep") : multipassTuningSuffix()), thresholdCandidates, [&](const Tuner::Variant& variant)
+      {
+        blockSortThreshold_ = variant[0];
+        mergeSortThreshold_ = variant[1];
+
+        double elapsed = 0.;
+        for (auto size : sizes)
+        {
+          Execution(engine_).toGpu(keyValues, size).run();
+
+          Execution execution(engine_, profileOptions);
+          recordSort(execution, keyValueLayout, keyValues, std::nullopt, size, keyBits);
+          execution.end();
+          execution.run();
+          elapsed += Tuner::gpuElapsed(execution) / size;
+        }
+        return elapsed;
+      }, shaderFilepaths);
+
+    blockSortThreshold_ = thresholds[0];
+    mergeSortThreshold_ = thresholds[1];
+  }
+
+  void check() const
+  {
+    if (!validator_)
+      throw std::runtime_error("RadixSort was not created with validation");
+
+    validator_->check();
+  }
+
+private:
+  std::string distributeFilename() const
+  {
+    return itemsPerThread_ > 1 ? "distribute_multisplit.comp.spv" : "distribute.comp.spv";
+  }
+
+  // Tuning cache name suffix of the multipass variant a measurement ran
+  std::string multipassTuningSuffix() const
+  {
+    return std::string(multisplit() ? "_multipass_multisplit" : "_multipass_2bit") + (skipUniformPasses_ ? "" : "_no_skip");
+  }
+
+  // Shaders of the large KeyValue sort path, hashed into the tuning cache key of its measurements
+  std::vector<std::string> largeSortShaderFilepaths(bool onesweep) const
+  {
+    if (onesweep)
+    {
+      return {
+        shaderDirpath_ + "\\radix_sort\\onesweep_histogram.comp.spv",
+        shaderDirpath_ + "\\radix_sort\\onesweep_scan.comp.spv",
+        shaderDirpath_ + "\\radix_sort\\onesweep_scatter.comp.spv",
+      };
+    }
+
+    return {
+      shaderDirpath_ + "\\radix_sort\\count.comp.spv",
+      shaderDirpath_ + "\\radix_sort\\scan_forward.comp.spv",
+      shaderDirpath_ + "\\radix_sort\\scan_backward.comp.spv",
+      shaderDirpath_ + "\\radix_sort\\" + distributeFilename(),
+      shaderDirpath_ + "\\radix_sort\\copy_back.comp.spv",
+    };
+  }
+
+  // Small KeyValue sorts in shared memory and merges, the rest with the configured radix sort
+  void recordSort(Execution& execution, const Layout& layout, DescriptorSet::BufferProxy elements, std::optional<DescriptorSet::BufferProxy> permutation, uint32_t count, uint32_t keyBits)
+  {
+    const auto keyValues = layout.elementWords == keyValueLayout.elementWords && layout.keyType == keyValueLayout.keyType && !permutation;
+    if (keyValues && (count <= blockSortThreshold_ || count <= mergeSortThreshold_))
+      recordSmall(execution, elements, count, keyBits);
+    else if (algorithm_ == Algorithm::Onesweep && keyValues)
+      recordOnesweep(execution, elements, count, keyBits);
+    else
+      recordMultipass(execution, layout, elements, permutation, count, keyBits, scan_);
+  }
+
+  ScanShaders createScanShaders(uint32_t scanBlockSize)
+  {
+    // Scratch is sized for the smallest scan block
+    if (scanBlockSize < scanBlockSizes.front())
+      throw std::runtime_error("Scan block size must be at least " + std::to_string(scanBlockSizes.front()));
+
+    if (!scanBlockSizeSupported(engine_, scanBlockSize))
+      throw std::runtime_error("Scan block size " + std::to_string(scanBlockSize) + " must be a multiple of the subgroup size and at most its square, within the workgroup size limits");
+
+    // Scan shaders take their block size as specialization constant 0
+    auto shaders = ComputeShader::createMany(engine_, {
+      {shaderDirpath_ + "\\radix_sort\\scan_forward.comp.spv", descriptorSetLayout_, {}, { scanBlockSize }},
+      {shaderDirpath_ + "\\radix_sort\\scan_backward.comp.spv", descriptorSetLayout_, {}, { scanBlockSize }},
+      });
+    return ScanShaders{ scanBlockSize, shaders[0], shaders[1] };
+  }
+
+  const SortShaders& sortShaders(const Layout& layout, bool permutation)
+  {
+    auto it = std::find_if(sortShaders_.begin(), sortShaders_.end(), [&layout, permutation](const auto& shaders)
+      {
+        return shaders.elementWords == layout.elementWords && shaders.keyType == layout.keyType && shaders.permutation == permutation;
+      });
+    if (it != sortShaders_.end())
+      return *it;
+
+    // ITEMS_PER_THREAD, ELEMENT_WORDS, KEY_TYPE, SEPARATE_VALUES and MIN_SUBGROUP_SIZE; 64-bit keys compare as unsigned words
+    const std::vector<uint32_t> specializationConstants = {
+      itemsPerThread_,
+      layout.elementWords,
+      layout.keyType == Validator::KeyType::Uint64 ? 0u : static_cast<uint32_t>(layout.keyType),
+      permutation ? 1u : 0u,
+      engine_.minSubgroupSize(),
+    };
+    auto shaders = ComputeShader::createMany(engine_, {
+      {shaderDirpath_ + "\\radix_sort\\count.comp.spv", descriptorSetLayout_, {}, specializationConstants},
+      {shaderDirpath_ + "\\radix_sort\\" + distributeFilename(), descriptorSetLayout_, {}, specializationConstants},
+      {shaderDirpath_ + "\\radix_sort\\copy_back.comp.spv", descriptorSetLayout_, {}, specializationConstants},
+      });
+    return *sortShaders_.insert(sortShaders_.end(), SortShaders{ layout.elementWords, layout.keyType, permutation, shaders[0], shaders[1], shaders[2] });
+  }
+
+  void createOnesweep()
+  {
+    if (!subgroupRankingSupported(engine_))
+      throw std::runtime_error("Onesweep radix sort is not supported on this device");
+
+    // Status words hold counts in 30 bits
+    if (maxCount_ >= (1u << 30))
+      throw std::runtime_error("Onesweep radix sort supports fewer than 2^30 elements");
+
+    onesweepLayout_.emplace(engine_, std::vector<vk::DescriptorType>(4, vk::DescriptorType::eStorageBuffer), true);
+    onesweepShaders_ = ComputeShader::createMany(engine_, {
+      {shaderDirpath_ + "\\radix_sort\\onesweep_histogram.comp.spv", *onesweepLayout_, {}},
+      {shaderDirpath_ + "\\radix_sort\\onesweep_scan.comp.spv", *onesweepLayout_, {}},
+      {shaderDirpath_ + "\\radix_sort\\onesweep_scatter.comp.spv", *onesweepLayout_, {}, { engine_.minSubgroupSize() }},
+      });
+
+    globalBuffer_.emplace(engine_, onesweepGlobalSize);
+    statusBuffer_.emplace(engine_, onesweepStatusSize(std::max(maxCount_, 1u)));
+    globalBuffer_->setName("radix_sort_onesweep_global");
+    statusBuffer_->setName("radix_sort_onesweep_status");
+  }
+
+  void checkArguments(const Layout& layout, uint32_t count, uint32_t keyBits) const
+  {
+    if (count > maxCount_)
+      throw std::runtime_error("RadixSort created for " + std::to_string(maxCount_) + " elements, but " + std::to_string(count) + " given");
+
+    const uint32_t maxKeyBits = layout.keyType == Validator::KeyType::Uint64 ? 64 : 32;
+    if (keyBits == 0 || keyBits > maxKeyBits)
+      throw std::runtime_error("Key bits must be in 1.." + std::to_string(maxKeyBits) + ", but " + std::to_string(keyBits) + " given");
+
+    // Sign bits are the top bits of the sortable keys
+    if ((layout.keyType == Validator::KeyType::Int || layout.keyType == Validator::KeyType::Float) && keyBits != 32)
+      throw std::runtime_error("Signed and float keys are sorted by all 32 bits, but " + std::to_string(keyBits) + " given");
+  }
+
+  void recordOnesweep(Execution& execution, DescriptorSet::BufferProxy keyValues, uint32_t count, uint32_t keyBits)
+  {
+    checkArguments(keyValueLayout, count, keyBits);
+
+    if (count == 0)
+      return;
+
+    const auto& histogramShader = onesweepShaders_[0];
+    const auto& scanShader = onesweepShaders_[1];
+    const auto& scatterShader = onesweepShaders_[2];
+
+    // Ping-pong between keyValues and outBuffer_ as in the multipass sort
+    const std::vector<DescriptorSet::BufferProxy> forwardBuffers = { keyValues, *globalBuffer_, outBuffer_, *statusBuffer_ };
+    const std::vector<DescriptorSet::BufferProxy> backwardBuffers = { outBuffer_, *globalBuffer_, keyValues, *statusBuffer_ };
+
+    const auto passCount = (keyBits + radixBits - 1) / radixBits;
+    const auto partitionCount = (count + onesweepTileSize - 1) / onesweepTileSize;
+
+    // Digit histograms of all passes from one read of the keys, then scanned to global digit offsets
+    const OnesweepHistogramInfo histogramInfo{ count, passCount };
+    execution
+      .fill(*globalBuffer_, onesweepGlobalSize, 0)
+      .barrier()
+      .name("onesweep_histogram")
+      .runComputeShader(histogramShader, forwardBuffers, partitionCount, histogramInfo)
+      .barrier()
+      .name("onesweep_scan")
+      .runComputeShader(scanShader, forwardBuffers, passCount, histogramInfo)
+      .barrier();
+
+    for (uint32_t pass = 0; pass < passCount; pass++)
+    {
+      const auto& buffers = pass % 2 == 0 ? forwardBuffers : backwardBuffers;
+
+      const OnesweepScatterInfo scatterInfo{ count, static_cast<int32_t>(pass * radixBits), pass };
+      execution
+        .fill(*statusBuffer_, onesweepStatusSize(count), 0)
+        .barrier()
+        .name("onesweep_scatter")
+        .runComputeShader(scatterShader, buffers, partitionCount, scatterInfo)
+        .barrier();
+    }
+
+    if (passCount % 2 == 1)
+    {
+      execution
+        .copy(outBuffer_, keyValues, sizeof(KeyValue) * static_cast<vk::DeviceSize>(count))
+        .barrier();
+    }
+  }
+
+  void recordSmall(Execution& execution, DescriptorSet::BufferProxy keyValues, uint32_t count, uint32_t keyBits)
+  {
+    checkArguments(keyValueLayout, count, keyBits);
+
+    if (count == 0)
+      return;
+
+    // A single run sorted by one workgroup, or runs of a whole tile merged pairwise until one is left
+    uint32_t sortSize = tileSize_;
+    if (count <= blockSortThreshold_)
+    {
+      sortSize = 1;
+      while (sortSize < count)
+        sortSize *= 2;
+    }
+
+    uint32_t mergePassCount = 0;
+    for (auto width = sortSize; width < count; width *= 2)
+      mergePassCount++;
+
+    // Passes alternate between keyValues and outBuffer_, the block sort writes to whichever makes the last pass end in keyValues
+    const DescriptorSet::BufferProxy buffers[2] = { keyValues, outBuffer_ };
+    auto target = mergePassCount % 2;
+
+    const SmallSortInfo smallSortInfo{ count, sortSize };
+    execution
+      .name("block_sort")
+      .runComputeShader(blockSortShader_, { keyValues, buffers[target] }, (count + sortSize - 1) / sortSize, smallSortInfo)
+      .barrier();
+
+    const auto mergeBlockSize = blockSize * mergeItemsPerThread;
+    for (auto width = sortSize; width < count; width *= 2)
+    {
+      const MergeInfo mergeInfo{ count, width };
+      execution
+        .name("merge")
+        .runComputeShader(mergeShader_, { buffers[target], buffers[1 - target] }, (count + mergeBlockSize - 1) / mergeBlockSize, mergeInfo)
+        .barrier();
+      target = 1 - target;
+    }
+  }
+
+  void recordMultipass(Execution& execution, const Layout& layout, DescriptorSet::BufferProxy elements, std::optional<DescriptorSet::BufferProxy> permutation, uint32_t count, uint32_t keyBits, const ScanShaders& scan)
+  {
+    checkArguments(layout, count, keyBits);
+
+    if (count == 0)
+      return;
+
+    const auto& shaders = sortShaders(layout, permutation.has_value());
+    const auto& countShader = shaders.count;
+    const auto& distributeShader = shaders.distribute;
+
+    // Passes alternate between elements and outBuffer_, and likewise between permutation and valueBuffer_.
+    // Passes whose digit is uniform are skipped on the GPU, so the kernels pick the direction themselves
+    // from the control buffer the first count fills. Bindings 3 and 4 are unused without a permutation.
+    const DescriptorSet::BufferProxy values = permutation ? *permutation : DescriptorSet::BufferProxy(counterBuffer_);
+    const DescriptorSet::BufferProxy outValues = permutation ? DescriptorSet::BufferProxy(*valueBuffer_) : DescriptorSet::BufferProxy(counterBuffer_);
+    // Distribute also counts the digits of the next moving pass into nextCounterBuffer_, which that pass's count
+    // takes over instead of reading the keys again.
+    const std::vector<DescriptorSet::BufferProxy> buffers = { elements, counterBuffer_, outBuffer_, values, outValues, controlBuffer_, nextCounterBuffer_ };
+
+    // One workgroup per tile, counter holds a digit count per tile
+    const auto tileSize = blockSize * itemsPerThread_;
+    const auto blockCount = (count + tileSize - 1) / tileSize;
+    const auto alignedSize = blockCount * blockSize;
+    SortInfo sortInfo;
+
+    // Key bits that differ between keys, all set to run every pass
+    execution
+      .fill(controlBuffer_, 2, skipUniformPasses_ ? 0u : ~0u)
+      .fill(nextCounterBuffer_, alignedSize, 0);
+
+    if (permutation)
+    {
+      sortInfo = { count, 0, 0 };
+      execution
+        .name("iota")
+        .runComputeShader(*iotaShader_, buffers, (count + blockSize - 1) / blockSize, sortInfo);
+    }
+    execution.barrier();
+
+    const auto passCount = (keyBits + radixBits - 1) / radixBits;
+    for (uint32_t bitOffset = 0; bitOffset < keyBits; bitOffset += radixBits)
+    {
+      sortInfo = { count, static_cast<int32_t>(bitOffset), 0 };
+      execution
+        .name("count")
+        .runComputeShader(countShader, buffers, blockCount, sortInfo)
+        .barrier();
+
+      // Scan forward
+      struct Phase
+      {
+        uint32_t simdSize;
+        uint32_t scanOffset;
+      };
+      std::vector<Phase> phases;
+      uint32_t scanOffset = 0;
+      uint32_t simdSize = alignedSize;
+      do
+      {
+        phases.push_back(Phase{ simdSize, scanOffset });
+        sortInfo = { simdSize, static_cast<int32_t>(bitOffset), scanOffset };
+        execution
+          .name("scan_forward")
+          .runComputeShader(scan.forward, buffers, (simdSize + scan.blockSize - 1) / scan.blockSize, sortInfo)
+          .barrier();
+        scanOffset += simdSize;
+        simdSize = (simdSize + scan.blockSize - 1) / scan.blockSize;
+      } while (simdSize > 1);
+
+      // Scan backward
+      for (int i = static_cast<int>(phases.size()) - 1; i >= 0; i--)
+      {
+        const auto& phase = phases[i];
+        sortInfo = { phase.simdSize, static_cast<int32_t>(bitOffset), phase.scanOffset };
+        execution
+          .name("scan_backward")
+          .runComputeShader(scan.backward, buffers, (phase.simdSize + scan.blockSize - 1) / scan.blockSize, sortInfo)
+          .barrier();
+      }
+
+      // Now prefix sum of counter[key][block_index], meaning start offset of each group
+      const DistributeInfo distributeInfo{ count, static_cast<int32_t>(bitOffset), static_cast<int32_t>(passCount * radixBits) };
+      execution
+        .name("distribute")
+        .runComputeShader(distributeShader, buffers, blockCount, distributeInfo)
+        .barrier();
+    }
+
+    // After an odd number of passes that ran the sorted array is in outBuffer_
+    sortInfo = { count, static_cast<int32_t>(passCount * radixBits), 0 };
+    execution
+      .name("copy_back")
+      .runComputeShader(shaders.copyBack, buffers, (count + blockSize - 1) / blockSize, sortInfo)
+      .barrier();
+  }
+
+  Engine engine_;
+  std::string shaderDirpath_;
+  uint32_t maxCount_;
+  Algorithm algorithm_;
+  bool skipUniformPasses_;
+  uint32_t tileSize_;
+  uint32_t blockSortThreshold_;
+  uint32_t mergeSortThreshold_;
+  uint32_t itemsPerThread_;
+
+  DescriptorSetLayout descriptorSetLayout_;
+  Buffer<uint32_t> outBuffer_;
+  Buffer<uint32_t> counterBuffer_;
+  Buffer<uint32_t> nextCounterBuffer_;
+  Buffer<uint32_t> controlBuffer_;
+
+  // Created on the first sort of each layout
+  std::vector<SortShaders> sortShaders_;
+  ScanShaders scan_;
+
+  // Small and medium KeyValue sorts
+  DescriptorSetLayout smallSortLayout_;
+  ComputeShader blockSortShader_;
+  ComputeShader mergeShader_;
+
+  // Permutation only
+  std::optional<Buffer<uint32_t>> valueBuffer_;
+  std::optional<ComputeShader> iotaShader_;
+
+  // Onesweep only
+  std::optional<DescriptorSetLayout> onesweepLayout_;
+  std::vector<ComputeShader> onesweepShaders_;
+  std::optional<Buffer<uint32_t>> globalBuffer_;
+  std::optional<Buffer<uint32_t>> statusBuffer_;
+
+  std::optional<Validator> validator_;
+};
+
+vk::DeviceSize RadixSort::scratchSize(const Options& options)
+{
+  const auto maxCount = std::max(options.maxCount, 1u);
+
+  vk::DeviceSize size = sizeof(KeyValue) * static_cast<vk::DeviceSize>(maxCount) + sizeof(uint32_t) * static_cast<vk::DeviceSize>(counterSize(maxCount, scanBlockSizes.front()) + histogramSize(maxCount) + 2);
+  if (options.permutation)
+    size += sizeof(uint32_t) * static_cast<vk::DeviceSize>(maxCount);
+  if (options.algorithm == Algorithm::Onesweep)
+    size += sizeof(uint32_t) * (static_cast<vk::DeviceSize>(onesweepGlobalSize) + onesweepStatusSize(maxCount));
+  return size;
+}
+
+bool RadixSort::subgroupRankingSupported(Engine engine)
+{
+  const auto properties = engine.physicalDevice().getProperties2<vk::PhysicalDeviceProperties2, vk::PhysicalDeviceSubgroupProperties>();
+  const auto& limits = properties.get<vk::PhysicalDeviceProperties2>().properties.limits;
+  const auto& subgroupProperties = properties.get<vk::PhysicalDeviceSubgroupProperties>();
+
+  // Subgroup digit counts, tile digit offsets and the partition index
+  const auto sharedSize = (blockSize / engine.minSubgroupSize() + 1) * 256 * sizeof(uint32_t) + sizeof(uint32_t);
+
+  const auto requiredOperations = vk::SubgroupFeatureFlagBits::eBasic | vk::SubgroupFeatureFlagBits::eBallot;
+  return engine.maxSubgroupSize() <= 128 && sharedSize <= limits.maxComputeSharedMemorySize &&
+    (subgroupProperties.supportedStages & vk::ShaderStageFlagBits::eCompute) &&
+    (subgroupProperties.supportedOperations & requiredOperations) == requiredOperations;
+}
+
+RadixSort::RadixSort(Engine engine, const std::string& shaderDirpath, const Options& options)
+  : impl_(std::make_shared<Impl>(engine, shaderDirpath, options))
+{
+}
+
+RadixSort::~RadixSort() = default;
+
+uint32_t RadixSort::maxCount() const noexcept
+{
+  return impl_->maxCount();
+}
+
+uint32_t RadixSort::scanBlockSize() const noexcept
+{
+  return impl_->scanBlockSize();
+}
+
+bool RadixSort::multisplit() const noexcept
+{
+  return impl_->multisplit();
+}
+
+RadixSort& RadixSort::sort(Execution& execution, const Buffer<KeyValue>& keyValues, uint32_t count, uint32_t keyBits)
+{
+  impl_->sort(execution, Impl::keyValueLayout, keyValues, std::nullopt, count, keyBits);
+  return *this;
+}
+
+void RadixSort::sort(Execution& execution, const Layout& layout, DescriptorSet::BufferProxy elements, std::optional<DescriptorSet::BufferProxy> permutation, uint32_t count, uint32_t keyBits)
+{
+  impl_->sort(execution, layout, elements, permutation, count, keyBits);
+}
+
+void RadixSort::tune(Tuner& tuner, const Buffer<KeyValue>& keyValues, uint32_t count, uint32_t keyBits)
+{
+  impl_->tune(tuner, keyValues, count, keyBits);
+}
+
+void RadixSort::check() const
+{
+  impl_->check();
+}
+}
+}
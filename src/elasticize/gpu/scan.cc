@@ -0,0 +1,237 @@
+#include <elasticize/gpu/scan.h>
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+#include <elasticize/gpu/engine.h>
+#include <elasticize/gpu/execution.h>
+#include <elasticize/gpu/compute_shader.h>
+#include <elasticize/gpu/descriptor_set_layout.h>
+
+namespace elastic
+{
+namespace gpu
+{
+namespace
+{
+// Invocations per workgroup of shader/scan/*.comp
+constexpr uint32_t blockSize = 256;
+
+struct ScanInfo
+{
+  uint32_t arraySize;
+  uint32_t exclusive;
+  uint32_t inputOffset;
+  uint32_t outputOffset;
+  uint32_t totalsOffset;
+};
+
+// Block totals of every level above the first, laid out level after level
+uint32_t totalsSize(uint32_t count)
+{
+  uint32_t size = 0;
+  for (auto levelSize = count; levelSize > Scan::tileSize; )
+  {
+    levelSize = (levelSize + Scan::tileSize - 1) / Scan::tileSize;
+    size += levelSize;
+  }
+  return size;
+}
+
+// Partition counter, then flag, aggregate and inclusive prefix of each partition
+uint32_t statusSize(uint32_t count)
+{
+  return 1 + 3 * ((count + Scan::tileSize - 1) / Scan::tileSize);
+}
+
+uint32_t scratchWords(const Scan::Options& options)
+{
+  const auto maxCount = std::max(options.maxCount, 1u);
+  return std::max(options.algorithm == Scan::Algorithm::MultiLevel ? totalsSize(maxCount) : statusSize(maxCount), 1u);
+}
+}
+
+class Scan::Impl
+{
+private:
+  // Specialized for a value type and operator, scan_block and scan_add or scan_look_back
+  struct ScanShaders
+  {
+    ValueType valueType;
+    Operator op;
+    std::vector<ComputeShader> shaders;
+  };
+
+public:
+  Impl() = delete;
+
+  Impl(Engine engine, const std::string& shaderDirpath, const Options& options)
+    : engine_(engine)
+    , shaderDirpath_(shaderDirpath)
+    , maxCount_(options.maxCount)
+    , algorithm_(options.algorithm)
+    , descriptorSetLayout_(engine, std::vector<vk::DescriptorType>(3, vk::DescriptorType::eStorageBuffer), true)
+    , scratchBuffer_(engine, scratchWords(options))
+  {
+    if (!supported(engine))
+      throw std::runtime_error("Scan needs subgroup arithmetic in compute shaders");
+
+    scratchBuffer_.setName("scan_scratch");
+  }
+
+  ~Impl() = default;
+
+  auto maxCount() const noexcept { return maxCount_; }
+
+  void scan(Execution& execution, ValueType valueType, Operator op, DescriptorSet::BufferProxy input, DescriptorSet::BufferProxy output, uint32_t count, bool exclusive)
+  {
+    if (count > maxCount_)
+      throw std::runtime_error("Scan created for " + std::to_string(maxCount_) + " elements, but " + std::to_string(count) + " given");
+
+    if (count == 0)
+      return;
+
+    const auto& shaders = scanShaders(valueType, op);
+    if (algorithm_ == Algorithm::DecoupledLookBack)
+      recordLookBack(execution, shaders, input, output, count, exclusive);
+    else
+      recordMultiLevel(execution, shaders, input, output, count, exclusive);
+  }
+
+private:
+  const ScanShaders& scanShaders(ValueType valueType, Operator op)
+  {
+    auto it = std::find_if(scanShaders_.begin(), scanShaders_.end(), [valueType, op](const auto& shaders)
+      {
+        return shaders.valueType == valueType && shaders.op == op;
+      });
+    if (it != scanShaders_.end())
+      return *it;
+
+    // VALUE_TYPE, OPERATOR and MIN_SUBGROUP_SIZE
+    const std::vector<uint32_t> specializationConstants = { static_cast<uint32_t>(valueType), static_cast<uint32_t>(op), engine_.minSubgroupSize() };
+    std::vector<ComputeShader> shaders;
+    if (algorithm_ == Algorithm::DecoupledLookBack)
+    {
+      shaders = ComputeShader::createMany(engine_, {
+        {shaderDirpath_ + "\\scan\\scan_look_back.comp.spv", descriptorSetLayout_, {}, specializationConstants},
+        });
+    }
+    else
+    {
+      shaders = ComputeShader::createMany(engine_, {
+        {shaderDirpath_ + "\\scan\\scan_block.comp.spv", descriptorSetLayout_, {}, specializationConstants},
+        {shaderDirpath_ + "\\scan\\scan_add.comp.spv", descriptorSetLayout_, {}, specializationConstants},
+        });
+    }
+    return *scanShaders_.insert(scanShaders_.end(), ScanShaders{ valueType, op, std::move(shaders) });
+  }
+
+  void recordMultiLevel(Execution& execution, const ScanShaders& shaders, DescriptorSet::BufferProxy input, DescriptorSet::BufferProxy output, uint32_t count, bool exclusive)
+  {
+    const auto& blockShader = shaders.shaders[0];
+    const auto& addShader = shaders.shaders[1];
+
+    // The first level reads input and writes output, the levels of block totals above it are scanned in place in scratch
+    struct Level
+    {
+      uint32_t size;
+      uint32_t offset;
+    };
+    std::vector<Level> levels = { { count, 0 } };
+    uint32_t offset = 0;
+    while (levels.back().size > tileSize)
+    {
+      const auto size = (levels.back().size + tileSize - 1) / tileSize;
+      levels.push_back({ size, offset });
+      offset += size;
+    }
+
+    const std::vector<DescriptorSet::BufferProxy> firstBuffers = { input, output, scratchBuffer_ };
+    const std::vector<DescriptorSet::BufferProxy> scratchBuffers = { scratchBuffer_, scratchBuffer_, scratchBuffer_ };
+
+    // Scan each level, writing tile totals to the level above
+    for (size_t i = 0; i < levels.size(); i++)
+    {
+      const auto& level = levels[i];
+      const auto totalsOffset = i + 1 < levels.size() ? levels[i + 1].offset : 0;
+      const ScanInfo scanInfo{ level.size, i == 0 ? exclusive : true, level.offset, level.offset, totalsOffset };
+      execution
+        .name("scan_block")
+        .runComputeShader(blockShader, i == 0 ? firstBuffers : scratchBuffers, (level.size + tileSize - 1) / tileSize, scanInfo)
+        .barrier();
+    }
+
+    // Add the scanned totals back down
+    for (int i = static_cast<int>(levels.size()) - 2; i >= 0; i--)
+    {
+      const auto& level = levels[i];
+      const ScanInfo scanInfo{ level.size, 0, level.offset, level.offset, levels[i + 1].offset };
+      execution
+        .name("scan_add")
+        .runComputeShader(addShader, i == 0 ? firstBuffers : scratchBuffers, (level.size + blockSize - 1) / blockSize, scanInfo)
+        .barrier();
+    }
+  }
+
+  void recordLookBack(Execution& execution, const ScanShaders& shaders, DescriptorSet::BufferProxy input, DescriptorSet::BufferProxy output, uint32_t count, bool exclusive)
+  {
+    const auto& lookBackShader = shaders.shaders[0];
+
+    const ScanInfo scanInfo{ count, exclusive, 0, 0, 0 };
+    execution
+      .fill(scratchBuffer_, statusSize(count), 0)
+      .barrier()
+      .name("scan_look_back")
+      .runComputeShader(lookBackShader, { input, output, scratchBuffer_ }, (count + tileSize - 1) / tileSize, scanInfo)
+      .barrier();
+  }
+
+  Engine engine_;
+  std::string shaderDirpath_;
+  uint32_t maxCount_;
+  Algorithm algorithm_;
+
+  DescriptorSetLayout descriptorSetLayout_;
+
+  // Block totals of the multi-level scan, or partition status of the look-back scan
+  Buffer<uint32_t> scratchBuffer_;
+
+  // Created on the first scan of each value type and operator
+  std::vector<ScanShaders> scanShaders_;
+};
+
+vk::DeviceSize Scan::scratchSize(const Options& options)
+{
+  return sizeof(uint32_t) * static_cast<vk::DeviceSize>(scratchWords(options));
+}
+
+bool Scan::supported(Engine engine)
+{
+  const auto properties = engine.physicalDevice().getProperties2<vk::PhysicalDeviceProperties2, vk::PhysicalDeviceSubgroupProperties>();
+  const auto& subgroupProperties = properties.get<vk::PhysicalDeviceSubgroupProperties>();
+
+  const auto requiredOperations = vk::SubgroupFeatureFlagBits::eBasic | vk::SubgroupFeatureFlagBits::eArithmetic;
+  return (subgroupProperties.supportedStages & vk::ShaderStageFlagBits::eCompute) &&
+    (subgroupProperties.supportedOperations & requiredOperations) == requiredOperations;
+}
+
+Scan::Scan(Engine engine, const std::string& shaderDirpath, const Options& options)
+  : impl_(std::make_shared<Impl>(engine, shaderDirpath, options))
+{
+}
+
+Scan::~Scan() = default;
+
+uint32_t Scan::maxCount() const noexcept
+{
+  return impl_->maxCount();
+}
+
+void Scan::scan(Execution& execution, ValueType valueType, Operator op, DescriptorSet::BufferProxy input, DescriptorSet::BufferProxy output, uint32_t count, bool exclusive)
+{
+  impl_->scan(execution, valueType, op, input, output, count, exclusive);
+}
+}
+}
@@ -0,0 +1,206 @@
+#include <elasticize/gpu/segmented_sort.h>
+
+#include <algorithm>
+#include <stdexcept>
+
+#include <elasticize/gpu/engine.h>
+#include <elasticize/gpu/execution.h>
+#include <elasticize/gpu/compute_shader.h>
+#include <elasticize/gpu/descriptor_set_layout.h>
+
+namespace elastic
+{
+namespace gpu
+{
+namespace
+{
+// Segment in batch shares a word with the 16-bit index in tile, see shader/radix_sort/bitonic_sort.glsl
+constexpr uint32_t maxBatchSegments = 1u << 16;
+
+struct Batch
+{
+  uint32_t firstSegment;
+  uint32_t lastSegment; // exclusive
+};
+
+struct BlockSortInfo
+{
+  uint32_t batchCount;
+};
+
+struct LargeSegment
+{
+  uint32_t begin;
+  uint32_t gatheredBegin;
+};
+
+struct LargeSortInfo
+{
+  uint32_t gatheredCount;
+  uint32_t largeCount;
+  uint32_t keyBits;
+};
+
+constexpr uint32_t largeBlockSize = 256;
+
+// Onesweep only sorts KeyValue layouts, so the 64-bit permutation sort of large segments is multipass
+RadixSort::Options radixSortOptions(const SegmentedSort::Options& options)
+{
+  RadixSort::Options radixSortOptions;
+  radixSortOptions.maxCount = options.maxCount;
+  radixSortOptions.permutation = true;
+  return radixSortOptions;
+}
+}
+
+class SegmentedSort::Impl
+{
+public:
+  Impl() = delete;
+
+  Impl(Engine engine, const std::string& shaderDirpath, const Options& options)
+    : maxCount_(options.maxCount)
+    , maxSegments_(options.maxSegments)
+    , descriptorSetLayout_(engine, { vk::DescriptorType::eStorageBuffer, vk::DescriptorType::eStorageBuffer, vk::DescriptorType::eStorageBuffer }, true)
+    , largeDescriptorSetLayout_(engine, std::vector<vk::DescriptorType>(6, vk::DescriptorType::eStorageBuffer), true)
+    , blockSortShader_(engine, ComputeShader::CreateInfo{ shaderDirpath + "\\segmented_sort\\block_sort.comp.spv", descriptorSetLayout_, {} })
+    , gatherShader_(engine, ComputeShader::CreateInfo{ shaderDirpath + "\\segmented_sort\\gather_large.comp.spv", largeDescriptorSetLayout_, {} })
+    , scatterShader_(engine, ComputeShader::CreateInfo{ shaderDirpath + "\\segmented_sort\\scatter_large.comp.spv", largeDescriptorSetLayout_, {} })
+    , batchBuffer_(engine, std::max(maxSegments_, 1u))
+    , largeSegmentBuffer_(engine, std::max(maxSegments_, 1u))
+    , gatheredBuffer_(engine, std::max(maxCount_, 1u))
+    , sortKeyBuffer_(engine, std::max(maxCount_, 1u))
+    , positionBuffer_(engine, std::max(maxCount_, 1u))
+    , permutationBuffer_(engine, std::max(maxCount_, 1u))
+    , radixSort_(engine, shaderDirpath, radixSortOptions(options))
+  {
+    batchBuffer_.setName("segmented_sort_batches");
+    largeSegmentBuffer_.setName("segmented_sort_large_segments");
+    gatheredBuffer_.setName("segmented_sort_gathered");
+    sortKeyBuffer_.setName("segmented_sort_sort_keys");
+    positionBuffer_.setName("segmented_sort_positions");
+    permutationBuffer_.setName("segmented_sort_permutation");
+  }
+
+  ~Impl() = default;
+
+  void sort(Execution& execution, const Buffer<KeyValue>& keyValues, const Buffer<uint32_t>& offsets, uint32_t segmentCount, uint32_t keyBits)
+  {
+    if (segmentCount > maxSegments_)
+      throw std::runtime_error("SegmentedSort created for " + std::to_string(maxSegments_) + " segments, but " + std::to_string(segmentCount) + " given");
+
+    if (segmentCount == 0)
+      return;
+
+    if (offsets[segmentCount] > maxCount_)
+      throw std::runtime_error("SegmentedSort created for " + std::to_string(maxCount_) + " elements, but " + std::to_string(offsets[segmentCount]) + " given");
+
+    // Planned from the host data of offsets, see the header. Consecutive small segments share a tile,
+    // large segments are gathered and sorted together
+    uint32_t batchCount = 0;
+    uint32_t largeCount = 0;
+    uint32_t gatheredCount = 0;
+    auto batchBegin = 0u;
+    for (uint32_t i = 0; i < segmentCount; i++)
+    {
+      if (offsets[i] > offsets[i + 1])
+        throw std::runtime_error("Segment offsets must not decrease, but segment " + std::to_string(i) + " ends before it begins");
+
+      const auto size = offsets[i + 1] - offsets[i];
+      const auto full = offsets[i + 1] - offsets[batchBegin] > tileSize || i - batchBegin >= maxBatchSegments;
+      if (size > tileSize || full)
+      {
+        if (batchBegin < i)
+          batchBuffer_[batchCount++] = { batchBegin, i };
+        batchBegin = i;
+      }
+
+      if (size > tileSize)
+      {
+        largeSegmentBuffer_[largeCount++] = { offsets[i], gatheredCount };
+        gatheredCount += size;
+        batchBegin = i + 1;
+      }
+    }
+    if (batchBegin < segmentCount)
+      batchBuffer_[batchCount++] = { batchBegin, segmentCount };
+
+    execution
+      .toGpu(offsets, segmentCount + 1)
+      .toGpu(batchBuffer_, batchCount)
+      .toGpu(largeSegmentBuffer_, largeCount)
+      .barrier();
+
+    if (batchCount > 0)
+    {
+      const BlockSortInfo blockSortInfo{ batchCount };
+      execution
+        .name("segmented_block_sort")
+        .runComputeShader(blockSortShader_, { keyValues, offsets, batchBuffer_ }, batchCount, blockSortInfo)
+        .barrier();
+    }
+
+    if (largeCount > 0)
+    {
+      // One radix sort of every large segment's elements by 64-bit keys of segment above key,
+      // a fixed number of dispatches however many segments there are
+      uint32_t segmentBits = 0;
+      while ((1ull << segmentBits) < largeCount)
+        segmentBits++;
+
+      const LargeSortInfo largeSortInfo{ gatheredCount, largeCount, keyBits };
+      const std::vector<DescriptorSet::BufferProxy> buffers = { keyValues, largeSegmentBuffer_, gatheredBuffer_, sortKeyBuffer_, positionBuffer_, permutationBuffer_ };
+      const auto groupCount = (gatheredCount + largeBlockSize - 1) / largeBlockSize;
+      execution
+        .name("segmented_gather_large")
+        .runComputeShader(gatherShader_, buffers, groupCount, largeSortInfo)
+        .barrier();
+      radixSort_.sortPermutation(execution, sortKeyBuffer_, permutationBuffer_, gatheredCount, keyBits + segmentBits);
+      execution
+        .name("segmented_scatter_large")
+        .runComputeShader(scatterShader_, buffers, groupCount, largeSortInfo)
+        .barrier();
+    }
+  }
+
+private:
+  uint32_t maxCount_;
+  uint32_t maxSegments_;
+
+  DescriptorSetLayout descriptorSetLayout_;
+  DescriptorSetLayout largeDescriptorSetLayout_;
+  ComputeShader blockSortShader_;
+  ComputeShader gatherShader_;
+  ComputeShader scatterShader_;
+
+  Buffer<Batch> batchBuffer_;
+  Buffer<LargeSegment> largeSegmentBuffer_;
+  Buffer<KeyValue> gatheredBuffer_;
+  Buffer<uint64_t> sortKeyBuffer_;
+  Buffer<uint32_t> positionBuffer_;
+  Buffer<uint32_t> permutationBuffer_;
+  RadixSort radixSort_;
+};
+
+vk::DeviceSize SegmentedSort::scratchSize(const Options& options)
+{
+  // Batches and large segments, then the gathered elements with their sort keys, positions and permutation
+  return (sizeof(Batch) + sizeof(LargeSegment)) * static_cast<vk::DeviceSize>(std::max(options.maxSegments, 1u)) +
+    (sizeof(KeyValue) + sizeof(uint64_t) + 2 * sizeof(uint32_t)) * static_cast<vk::DeviceSize>(std::max(options.maxCount, 1u)) +
+    RadixSort::scratchSize(radixSortOptions(options));
+}
+
+SegmentedSort::SegmentedSort(Engine engine, const std::string& shaderDirpath, const Options& options)
+  : impl_(std::make_shared<Impl>(engine, shaderDirpath, options))
+{
+}
+
+SegmentedSort::~SegmentedSort() = default;
+
+SegmentedSort& SegmentedSort::sort(Execution& execution, const Buffer<KeyValue>& keyValues, const Buffer<uint32_t>& offsets, uint32_t segmentCount, uint32_t keyBits)
+{
+  impl_->sort(execution, keyValues, offsets, segmentCount, keyBits);
+  return *this;
+}
+}
+}
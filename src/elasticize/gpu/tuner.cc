@@ -0,0 +1,234 @@
+#include <elasticize/gpu/tuner.h>
+
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <algorithm>
+#include <map>
+#include <limits>
+#include <stdexcept>
+
+#include <elasticize/gpu/execution.h>
+
+namespace elastic
+{
+namespace gpu
+{
+namespace
+{
+std::string createDeviceKey(vk::PhysicalDevice physicalDevice)
+{
+  const auto properties = physicalDevice.getProperties2<vk::PhysicalDeviceProperties2, vk::PhysicalDeviceIDProperties>();
+  const auto& deviceUUID = properties.get<vk::PhysicalDeviceIDProperties>().deviceUUID;
+
+  std::ostringstream ss;
+  ss << std::hex << std::setfill('0');
+  for (auto byte : deviceUUID)
+    ss << std::setw(2) << static_cast<uint32_t>(byte);
+  ss << '-' << properties.get<vk::PhysicalDeviceProperties2>().properties.driverVersion;
+  return ss.str();
+}
+
+// 64-bit FNV-1a of the files' contents, or "-" for no files
+std::string createShaderKey(const std::vector<std::string>& filepaths)
+{
+  if (filepaths.empty())
+    return "-";
+
+  uint64_t hash = 14695981039346656037ull;
+  for (const auto& filepath : filepaths)
+  {
+    std::ifstream file(filepath, std::ios::binary);
+    if (!file.is_open())
+      throw std::runtime_error("Failed to open file: " + filepath);
+
+    char c;
+    while (file.get(c))
+    {
+      hash ^= static_cast<uint8_t>(c);
+      hash *= 1099511628211ull;
+    }
+  }
+
+  std::ostringstream ss;
+  ss << std::hex << std::setfill('0') << std::setw(16) << hash;
+  return ss.str();
+}
+}
+
+class Tuner::Impl
+{
+public:
+  Impl() = delete;
+
+  Impl(Engine engine, const Options& options)
+    : engine_(engine)
+    , options_(options)
+    , deviceKey_(createDeviceKey(engine.physicalDevice()))
+  {
+    if (options_.repetitions == 0)
+      throw std::runtime_error("Tuner needs at least one repetition");
+
+    load();
+  }
+
+  ~Impl() = default;
+
+  const std::string& deviceKey() const noexcept
+  {
+    return deviceKey_;
+  }
+
+  Variant lookup(const std::string& name, const std::vector<std::string>& shaderFilepaths) const
+  {
+    auto it = winners_.find(name);
+    return it != winners_.end() && it->second.shaderKey == createShaderKey(shaderFilepaths) ? it->second.variant : Variant();
+  }
+
+  Variant tune(const std::string& name, const std::vector<Variant>& candidates, std::function<double(const Variant&)> measure, const std::vector<std::string>& shaderFilepaths)
+  {
+    if (name.empty() || name.find_first_of(" \t\n") != std::string::npos)
+      throw std::runtime_error("Invalid tuning name: \"" + name + "\"");
+
+    if (candidates.empty())
+      throw std::runtime_error("No candidates to tune " + name);
+
+    // A cached winner is reused only if it was tuned with the same shaders and is still among the candidates
+    const auto shaderKey = createShaderKey(shaderFilepaths);
+    auto it = winners_.find(name);
+    if (it != winners_.end() && it->second.shaderKey == shaderKey &&
+      std::find(candidates.begin(), candidates.end(), it->second.variant) != candidates.end())
+      return it->second.variant;
+
+    Variant best;
+    auto bestTime = std::numeric_limits<double>::max();
+    for (const auto& candidate : candidates)
+    {
+      // First run compiles the pipeline and touches memory, not measured
+      measure(candidate);
+
+      std::vector<double> samples;
+      for (uint32_t i = 0; i < options_.repetitions; i++)
+        samples.push_back(measure(candidate));
+
+      std::sort(samples.begin(), samples.end());
+      const auto median = samples[samples.size() / 2];
+
+      if (options_.measured)
+        options_.measured(name, candidate, median);
+
+      if (median < bestTime)
+      {
+        bestTime = median;
+        best = candidate;
+      }
+    }
+
+    winners_[name] = { shaderKey, best };
+    save(name, winners_[name]);
+    return best;
+  }
+
+  ComputeShader computeShader(const std::string& name, ComputeShader::CreateInfo createInfo) const
+  {
+    auto winner = lookup(name, { createInfo.filepath });
+    if (!winner.empty())
+      createInfo.specializationConstants = std::move(winner);
+    return ComputeShader(engine_, createInfo);
+  }
+
+private:
+  struct Winner
+  {
+    std::string shaderKey;
+    Variant variant;
+  };
+
+  // One line per winner: <device key> <name> <shader key> <value>...
+  // Later lines override earlier ones, so saving only appends.
+  void load()
+  {
+    if (options_.cacheFilepath.empty())
+      return;
+
+    std::ifstream in(options_.cacheFilepath);
+    std::string line;
+    while (std::getline(in, line))
+    {
+      std::istringstream ss(line);
+      std::string deviceKey;
+      std::string name;
+      Winner winner;
+      if (!(ss >> deviceKey >> name >> winner.shaderKey) || deviceKey != deviceKey_)
+        continue;
+
+      uint32_t value;
+      while (ss >> value)
+        winner.variant.push_back(value);
+      winners_[name] = winner;
+    }
+  }
+
+  void save(const std::string& name, const Winner& winner) const
+  {
+    if (options_.cacheFilepath.empty())
+      return;
+
+    std::ofstream out(options_.cacheFilepath, std::ios::app);
+    if (!out)
+      throw std::runtime_error("Failed to open file: " + options_.cacheFilepath);
+
+    out << deviceKey_ << ' ' << name << ' ' << winner.shaderKey;
+    for (auto value : winner.variant)
+      out << ' ' << value;
+    out << std::endl;
+  }
+
+  Engine engine_;
+  Options options_;
+  std::string deviceKey_;
+  std::map<std::string, Winner> winners_;
+};
+
+double Tuner::gpuElapsed(const Execution& execution)
+{
+  double elapsed = 0.;
+  for (const auto& command : execution.report())
+    elapsed += command.elapsed;
+  return elapsed * 1e-3;
+}
+
+Tuner::Tuner(Engine engine)
+  : Tuner(engine, Options())
+{
+}
+
+Tuner::Tuner(Engine engine, const Options& options)
+  : impl_(std::make_shared<Impl>(engine, options))
+{
+}
+
+Tuner::~Tuner() = default;
+
+const std::string& Tuner::deviceKey() const noexcept
+{
+  return impl_->deviceKey();
+}
+
+Tuner::Variant Tuner::lookup(const std::string& name, const std::vector<std::string>& shaderFilepaths) const
+{
+  return impl_->lookup(name, shaderFilepaths);
+}
+
+Tuner::Variant Tuner::tune(const std::string& name, const std::vector<Variant>& candidates, std::function<double(const Variant&)> measure,
+  const std::vector<std::string>& shaderFilepaths)
+{
+  return impl_->tune(name, candidates, std::move(measure), shaderFilepaths);
+}
+
+ComputeShader Tuner::computeShader(const std::string& name, ComputeShader::CreateInfo createInfo) const
+{
+  return impl_->computeShader(name, std::move(createInfo));
+}
+}
+}
@@ -0,0 +1,214 @@
+#include <elasticize/gpu/validator.h>
+
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+
+#include <elasticize/gpu/engine.h>
+#include <elasticize/gpu/execution.h>
+#include <elasticize/gpu/compute_shader.h>
+#include <elasticize/gpu/descriptor_set_layout.h>
+
+namespace elastic
+{
+namespace gpu
+{
+namespace
+{
+constexpr uint32_t blockSize = 256;
+
+struct IsSortedInfo
+{
+  uint32_t arraySize;
+  uint32_t stride;
+  uint32_t keyType;
+  uint32_t segmentCount;
+};
+
+struct ChecksumInfo
+{
+  uint32_t arraySize;
+  uint32_t stride;
+  uint32_t slot;
+};
+
+struct ScanCheckInfo
+{
+  uint32_t arraySize;
+  uint32_t exclusive;
+};
+}
+
+static_assert(sizeof(Validator::Result) == 8 * sizeof(uint32_t), "Result must match the shader layout");
+
+class Validator::Impl
+{
+public:
+  Impl() = delete;
+
+  Impl(Engine engine, const std::string& shaderDirpath)
+    : resultBuffer_(engine, 1)
+    , arrayLayout_(engine, { vk::DescriptorType::eStorageBuffer, vk::DescriptorType::eStorageBuffer }, true)
+    , sortedLayout_(engine, { vk::DescriptorType::eStorageBuffer, vk::DescriptorType::eStorageBuffer, vk::DescriptorType::eStorageBuffer }, true)
+    , scanLayout_(engine, { vk::DescriptorType::eStorageBuffer, vk::DescriptorType::eStorageBuffer, vk::DescriptorType::eStorageBuffer }, true)
+    , shaders_(ComputeShader::createMany(engine, {
+      {shaderDirpath + "\\validate\\is_sorted.comp.spv", sortedLayout_, {}},
+      {shaderDirpath + "\\validate\\checksum.comp.spv", arrayLayout_, {}},
+      {shaderDirpath + "\\validate\\scan_check.comp.spv", scanLayout_, {}},
+      }))
+  {
+    resultBuffer_.setName("validator_result");
+  }
+
+  ~Impl() = default;
+
+  void begin(Execution& execution)
+  {
+    resultBuffer_[0] = Result();
+    sortedChecked_ = false;
+    checksumSlots_ = 0;
+    scanChecked_ = false;
+
+    execution
+      .name("validate_begin")
+      .toGpu(resultBuffer_)
+      .barrier();
+  }
+
+  // Without offsets the result buffer stands in for the unused offsets binding
+  void isSorted(Execution& execution, DescriptorSet::BufferProxy buffer, std::optional<DescriptorSet::BufferProxy> offsets, uint32_t segmentCount, uint32_t count, uint32_t stride, KeyType keyType)
+  {
+    sortedChecked_ = true;
+
+    const DescriptorSet::BufferProxy offsetBuffer = offsets ? *offsets : DescriptorSet::BufferProxy(resultBuffer_);
+    const IsSortedInfo isSortedInfo{ count, stride, static_cast<uint32_t>(keyType), offsets ? segmentCount : 0u };
+    execution
+      .runComputeShader(shaders_[0], { buffer, resultBuffer_, offsetBuffer }, groupCount(count), isSortedInfo)
+      .barrier();
+  }
+
+  void checksum(Execution& execution, DescriptorSet::BufferProxy buffer, uint32_t count, uint32_t stride, uint32_t slot)
+  {
+    if (slot > 1)
+      throw std::runtime_error("Checksum slot must be 0 or 1, but " + std::to_string(slot) + " given");
+
+    checksumSlots_ |= 1u << slot;
+
+    const ChecksumInfo checksumInfo{ count, stride, slot };
+    execution
+      .runComputeShader(shaders_[1], { buffer, resultBuffer_ }, groupCount(count), checksumInfo)
+      .barrier();
+  }
+
+  void scan(Execution& execution, const Buffer<uint32_t>& input, const Buffer<uint32_t>& output, uint32_t count, bool exclusive)
+  {
+    scanChecked_ = true;
+
+    const ScanCheckInfo scanCheckInfo{ count, exclusive ? 1u : 0u };
+    execution
+      .runComputeShader(shaders_[2], { input, resultBuffer_, output }, groupCount(count), scanCheckInfo)
+      .barrier();
+  }
+
+  void end(Execution& execution)
+  {
+    execution
+      .name("validate_end")
+      .fromGpu(resultBuffer_);
+  }
+
+  const Result& result() const
+  {
+    return resultBuffer_[0];
+  }
+
+  void check() const
+  {
+    const auto& result = resultBuffer_[0];
+
+    std::ostringstream ss;
+    if (sortedChecked_ && !result.sorted())
+      ss << " " << result.unsorted << " unsorted elements, first at " << result.firstUnsorted << ";";
+    if (checksumSlots_ == 3 && !result.permutation())
+      ss << " checksums differ, not a permutation;";
+    if (scanChecked_ && !result.scanConsistent())
+      ss << " " << result.scanMismatches << " scan mismatches, first at " << result.firstScanMismatch << ";";
+
+    const auto errors = ss.str();
+    if (!errors.empty())
+      throw std::runtime_error("Validation failed:" + errors);
+  }
+
+private:
+  static uint32_t groupCount(uint32_t count)
+  {
+    return (count + blockSize - 1) / blockSize;
+  }
+
+  Buffer<Result> resultBuffer_;
+  DescriptorSetLayout arrayLayout_;
+  DescriptorSetLayout sortedLayout_;
+  DescriptorSetLayout scanLayout_;
+  std::vector<ComputeShader> shaders_;
+
+  // Checks recorded since begin()
+  bool sortedChecked_ = false;
+  uint32_t checksumSlots_ = 0;
+  bool scanChecked_ = false;
+};
+
+Validator::Validator(Engine engine, const std::string& shaderDirpath)
+  : impl_(std::make_shared<Impl>(engine, shaderDirpath))
+{
+}
+
+Validator::~Validator() = default;
+
+Validator& Validator::begin(Execution& execution)
+{
+  impl_->begin(execution);
+  return *this;
+}
+
+Validator& Validator::isSorted(Execution& execution, DescriptorSet::BufferProxy buffer, uint32_t count, uint32_t stride, KeyType keyType)
+{
+  impl_->isSorted(execution, buffer, std::nullopt, 0, count, stride, keyType);
+  return *this;
+}
+
+Validator& Validator::isSegmentSorted(Execution& execution, DescriptorSet::BufferProxy buffer, const Buffer<uint32_t>& offsets, uint32_t segmentCount, uint32_t count, uint32_t stride, KeyType keyType)
+{
+  // No segments leave nothing to check
+  impl_->isSorted(execution, buffer, DescriptorSet::BufferProxy(offsets), segmentCount, segmentCount > 0 ? count : 0, stride, keyType);
+  return *this;
+}
+
+Validator& Validator::checksum(Execution& execution, DescriptorSet::BufferProxy buffer, uint32_t count, uint32_t stride, uint32_t slot)
+{
+  impl_->checksum(execution, buffer, count, stride, slot);
+  return *this;
+}
+
+Validator& Validator::scan(Execution& execution, const Buffer<uint32_t>& input, const Buffer<uint32_t>& output, uint32_t count, bool exclusive)
+{
+  impl_->scan(execution, input, output, count, exclusive);
+  return *this;
+}
+
+Validator& Validator::end(Execution& execution)
+{
+  impl_->end(execution);
+  return *this;
+}
+
+const Validator::Result& Validator::result() const
+{
+  return impl_->result();
+}
+
+void Validator::check() const
+{
+  impl_->check();
+}
+}
+}
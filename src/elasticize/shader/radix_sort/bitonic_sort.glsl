@@ -0,0 +1,58 @@
+// Stable bitonic sort of a tile of key-value pairs in shared memory, for radix_sort/block_sort.comp and
+// segmented_sort/block_sort.comp. The including shader defines BLOCK_SIZE and TILE_SIZE, at most 1 << INDEX_BITS.
+
+const int INDEX_BITS = 16;
+
+shared uint keys[TILE_SIZE];
+shared uint values[TILE_SIZE];
+shared uint orders[TILE_SIZE]; // segment << INDEX_BITS | index in tile
+
+// Element i of the tile, sorted by segment first, then key, then i
+void setItem(uint i, uint segment, uint key, uint value) {
+  keys[i] = key;
+  values[i] = value;
+  orders[i] = (segment << INDEX_BITS) | i;
+}
+
+// Padding sorts after every element
+void setPadding(uint i) {
+  keys[i] = 0xffffffffu;
+  values[i] = 0;
+  orders[i] = 0xffffffffu;
+}
+
+bool greater(uint lhs, uint rhs) {
+  const uint lhs_segment = orders[lhs] >> INDEX_BITS;
+  const uint rhs_segment = orders[rhs] >> INDEX_BITS;
+  if (lhs_segment != rhs_segment)
+    return lhs_segment > rhs_segment;
+  if (keys[lhs] != keys[rhs])
+    return keys[lhs] > keys[rhs];
+  return orders[lhs] > orders[rhs];
+}
+
+// Sorts the first sort_size elements, a power of two no larger than TILE_SIZE, with sort_size / 2 compare-exchanges
+// per step. Elements must be set and visible to the workgroup before the call, and are visible after it.
+void bitonicSort(uint sort_size) {
+  for (uint k = 2; k <= sort_size; k <<= 1) {
+    for (uint j = k >> 1; j > 0; j >>= 1) {
+      for (uint p = gl_LocalInvocationID.x; p < sort_size / 2; p += BLOCK_SIZE) {
+        const uint lhs = 2 * j * (p / j) + p % j;
+        const uint rhs = lhs + j;
+        const bool ascending = (lhs & k) == 0;
+        if (greater(lhs, rhs) == ascending) {
+          const uint key = keys[lhs];
+          const uint value = values[lhs];
+          const uint order = orders[lhs];
+          keys[lhs] = keys[rhs];
+          values[lhs] = values[rhs];
+          orders[lhs] = orders[rhs];
+          keys[rhs] = key;
+          values[rhs] = value;
+          orders[rhs] = order;
+        }
+      }
+      barrier();
+    }
+  }
+}
@@ -0,0 +1,33 @@
+// Shared by the multipass shaders of shader/radix_sort, included with GL_GOOGLE_include_directive
+
+const int RADIX_BITS = 8;
+const int RADIX_SIZE = 1 << 8;
+
+// Element layout, see RadixSort::sortKeys()
+layout (constant_id = 2) const int KEY_TYPE = 0; // 0 uint, 1 int, 2 float
+
+layout (std430, binding = 5) buffer ControlSsbo {
+  uint key_diff[2]; // bits in which some key differs from the first key, per key word
+} control;
+
+// Key word with bits ordered like unsigned integers
+uint sortable(uint word) {
+  if (KEY_TYPE == 1)
+    return word ^ 0x80000000u;
+  else if (KEY_TYPE == 2)
+    return word ^ ((word & 0x80000000u) != 0 ? 0xffffffffu : 0x80000000u);
+  return word;
+}
+
+// Passes whose digit is the same for every key leave the elements where they are
+bool passSkipped(int offset) {
+  return bitfieldExtract(control.key_diff[offset / 32], offset % 32, RADIX_BITS) == 0;
+}
+
+// Elements are in the out bindings after an odd number of moving passes before end
+uint sourceParity(int end) {
+  uint result = 0;
+  for (int offset = 0; offset < end; offset += RADIX_BITS)
+    result ^= passSkipped(offset) ? 0u : 1u;
+  return result;
+}
@@ -0,0 +1,97 @@
+// Element moves of distribute.comp and distribute_multisplit.comp, included after common.glsl.
+// The including shader defines ELEMENT_WORDS, SEPARATE_VALUES and TILE_SIZE, the keys a workgroup moves.
+
+layout (push_constant) uniform DistributeInfo {
+  uint array_size;
+  int bit_offset;
+  int pass_end; // bit offset one past the last pass
+};
+
+layout (std430, binding = 0) buffer ArraySsbo {
+  uint data[];
+} array;
+
+layout (std430, binding = 1) buffer CounterSsbo {
+  uint data[]; // Prefix sum for each workgroup
+} counter;
+
+layout (std430, binding = 2) buffer OutArraySsbo {
+  uint data[];
+} out_array;
+
+layout (std430, binding = 3) buffer ValueSsbo {
+  uint data[];
+} values;
+
+layout (std430, binding = 4) buffer OutValueSsbo {
+  uint data[];
+} out_values;
+
+layout (std430, binding = 6) buffer NextCounterSsbo {
+  uint data[]; // Digit counts of the next moving pass for each workgroup, accumulated by distribute
+} next_counter;
+
+uint parity;
+
+uint loadWord(uint index) {
+  return parity == 0 ? array.data[index] : out_array.data[index];
+}
+
+void storeWord(uint index, uint word) {
+  if (parity == 0)
+    out_array.data[index] = word;
+  else
+    array.data[index] = word;
+}
+
+// Element src of the source bindings to dst of the destination bindings, returns its key word word_index
+uint moveElement(uint src, uint dst, int word_index) {
+  uint result = 0;
+  for (int i = 0; i < ELEMENT_WORDS; i++) {
+    const uint word = loadWord(src * ELEMENT_WORDS + i);
+    if (i == word_index)
+      result = word;
+    storeWord(dst * ELEMENT_WORDS + i, word);
+  }
+
+  if (SEPARATE_VALUES != 0) {
+    if (parity == 0)
+      out_values.data[dst] = values.data[src];
+    else
+      values.data[dst] = out_values.data[src];
+  }
+  return result;
+}
+
+// Bit offset of the next pass that moves elements, or -1 after the last
+int nextPassOffset() {
+  for (int offset = bit_offset + RADIX_BITS; offset < pass_end; offset += RADIX_BITS) {
+    if (!passSkipped(offset))
+      return offset;
+  }
+  return -1;
+}
+
+int next_offset;
+
+// Counts a moved key for the digit of the next pass in the tile it lands in. Keys of a subgroup land in
+// few tiles, so lanes sharing a counter are peeled off together and add with a single atomic.
+void countNext(uint dst, uint word) {
+  const uint digit = bitfieldExtract(sortable(word), next_offset % 32, RADIX_BITS);
+  const uint slot = digit * gl_NumWorkGroups.x + dst / TILE_SIZE;
+  while (true) {
+    if (slot == subgroupBroadcastFirst(slot)) {
+      const uint peers = subgroupBallotBitCount(subgroupBallot(true));
+      if (subgroupElect())
+        atomicAdd(next_counter.data[slot], peers);
+      break;
+    }
+  }
+}
+
+// Moves element src to dst and counts it for the next moving pass
+void distributeElement(uint src, uint dst) {
+  const uint word = moveElement(src, dst, next_offset / 32);
+  if (next_offset >= 0)
+    countNext(dst, word);
+}
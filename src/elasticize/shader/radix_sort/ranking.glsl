@@ -0,0 +1,48 @@
+// Ballot ranking of distribute_multisplit.comp and onesweep_scatter.comp, with one digit per invocation after it.
+// The including shader defines BLOCK_SIZE equal to RADIX_SIZE, RADIX_BITS and MIN_SUBGROUP_SIZE,
+// the smallest subgroups the device may split the workgroup into.
+
+const int MAX_SUBGROUPS = BLOCK_SIZE / MIN_SUBGROUP_SIZE;
+
+// Keys of each digit a subgroup ranked so far, then the subgroup's offset within the tile's run of the digit
+shared uint subgroup_offset[MAX_SUBGROUPS][RADIX_SIZE];
+
+void clearSubgroupOffsets() {
+  for (int i = 0; i < MAX_SUBGROUPS; i++)
+    subgroup_offset[i][gl_LocalInvocationID.x] = 0;
+}
+
+// Rank of a key among the subgroup's keys of its digit, counting earlier calls, so ranks follow lane order
+uint rankDigit(uint digit, bool in_range) {
+  // Lanes holding the same digit, all 8 bits matched with one ballot each instead of 2-bit local sorts
+  uvec4 peers = subgroupBallot(in_range);
+  for (int bit = 0; bit < RADIX_BITS; bit++) {
+    const bool set = bitfieldExtract(digit, bit, 1) != 0;
+    const uvec4 vote = subgroupBallot(set);
+    peers &= set ? vote : ~vote;
+  }
+  const uint rank = subgroupBallotBitCount(peers & gl_SubgroupLtMask);
+
+  const uint result = subgroup_offset[gl_SubgroupID][digit] + rank;
+  subgroupMemoryBarrierShared();
+  subgroupBarrier();
+
+  // The lowest lane of each digit advances the running count
+  if (in_range && rank == 0)
+    subgroup_offset[gl_SubgroupID][digit] += subgroupBallotBitCount(peers);
+  subgroupMemoryBarrierShared();
+  subgroupBarrier();
+
+  return result;
+}
+
+// Subgroup counts of digit to offsets within the tile's run of that digit, returns the tile's count of it
+uint scanSubgroupOffsets(uint digit) {
+  uint offset = 0;
+  for (int i = 0; i < gl_NumSubgroups; i++) {
+    const uint count = subgroup_offset[i][digit];
+    subgroup_offset[i][digit] = offset;
+    offset += count;
+  }
+  return offset;
+}
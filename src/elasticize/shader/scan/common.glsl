@@ -0,0 +1,100 @@
+// Shared by the shaders of shader/scan, included with GL_GOOGLE_include_directive.
+// The including shader defines BLOCK_SIZE and enables subgroup basic and arithmetic operations.
+
+layout (constant_id = 0) const int VALUE_TYPE = 0; // 0 uint, 1 int, 2 float
+layout (constant_id = 1) const int OPERATOR = 0;   // 0 sum, 1 max, 2 min
+
+// Smallest subgroups the device may split a workgroup into, Engine::minSubgroupSize()
+layout (constant_id = 2) const int MIN_SUBGROUP_SIZE = 1;
+const int MAX_SUBGROUPS = BLOCK_SIZE / MIN_SUBGROUP_SIZE;
+
+// Offsets in elements, levels above the first of a multi-level scan read and write the scratch buffer.
+// scan_add.comp ignores exclusive and input_offset, scan_look_back.comp scans a single level without offsets.
+layout (push_constant) uniform ScanInfo {
+  uint array_size;
+  uint exclusive;
+  uint input_offset;
+  uint output_offset;
+  uint totals_offset;
+};
+
+// Values are bit patterns of VALUE_TYPE
+uint identity() {
+  if (OPERATOR == 1)
+    return VALUE_TYPE == 2 ? 0xff800000u : VALUE_TYPE == 1 ? 0x80000000u : 0u;
+  else if (OPERATOR == 2)
+    return VALUE_TYPE == 2 ? 0x7f800000u : VALUE_TYPE == 1 ? 0x7fffffffu : 0xffffffffu;
+  return 0u;
+}
+
+uint combine(uint lhs, uint rhs) {
+  if (VALUE_TYPE == 2) {
+    const float x = uintBitsToFloat(lhs);
+    const float y = uintBitsToFloat(rhs);
+    return floatBitsToUint(OPERATOR == 1 ? max(x, y) : OPERATOR == 2 ? min(x, y) : x + y);
+  }
+  else if (VALUE_TYPE == 1) {
+    const int x = int(lhs);
+    const int y = int(rhs);
+    return uint(OPERATOR == 1 ? max(x, y) : OPERATOR == 2 ? min(x, y) : x + y);
+  }
+  return OPERATOR == 1 ? max(lhs, rhs) : OPERATOR == 2 ? min(lhs, rhs) : lhs + rhs;
+}
+
+#define TYPED_SCAN(scan) \
+  if (VALUE_TYPE == 2) \
+    return floatBitsToUint(scan(uintBitsToFloat(value))); \
+  else if (VALUE_TYPE == 1) \
+    return uint(scan(int(value))); \
+  return scan(value);
+
+uint subgroupReduce(uint value) {
+  if (OPERATOR == 1) {
+    TYPED_SCAN(subgroupMax)
+  }
+  else if (OPERATOR == 2) {
+    TYPED_SCAN(subgroupMin)
+  }
+  TYPED_SCAN(subgroupAdd)
+}
+
+uint subgroupExclusive(uint value) {
+  if (OPERATOR == 1) {
+    TYPED_SCAN(subgroupExclusiveMax)
+  }
+  else if (OPERATOR == 2) {
+    TYPED_SCAN(subgroupExclusiveMin)
+  }
+  TYPED_SCAN(subgroupExclusiveAdd)
+}
+
+shared uint subgroup_totals[MAX_SUBGROUPS];
+shared uint workgroup_total;
+
+// Exclusive scan of one value per invocation across the workgroup, all of them combined in workgroup_total
+uint workgroupExclusive(uint value) {
+  const uint subgroup_prefix = subgroupExclusive(value);
+  const uint subgroup_total = subgroupReduce(value);
+  if (subgroupElect())
+    subgroup_totals[gl_SubgroupID] = subgroup_total;
+  barrier();
+
+  // The first subgroup scans the subgroup totals, a subgroup's worth at a time when there are more of them
+  if (gl_SubgroupID == 0) {
+    uint carry = identity();
+    for (uint first = 0; first < gl_NumSubgroups; first += gl_SubgroupSize) {
+      const uint index = first + gl_SubgroupInvocationID;
+      const bool in_range = index < gl_NumSubgroups;
+      const uint total = in_range ? subgroup_totals[index] : identity();
+      const uint prefix = combine(carry, subgroupExclusive(total));
+      if (in_range)
+        subgroup_totals[index] = prefix;
+      carry = combine(carry, subgroupReduce(total));
+    }
+    if (subgroupElect())
+      workgroup_total = carry;
+  }
+  barrier();
+
+  return combine(subgroup_totals[gl_SubgroupID], subgroup_prefix);
+}
@@ -0,0 +1,41 @@
+// Shared by gather_large.comp and scatter_large.comp, included with GL_GOOGLE_include_directive.
+// Elements of every segment larger than a tile are gathered and radix sorted once by segment and key.
+
+const int BLOCK_SIZE = 256;
+
+layout (local_size_x = BLOCK_SIZE) in;
+
+layout (push_constant) uniform LargeSortInfo {
+  uint gathered_count;
+  uint large_count;
+  uint key_bits;
+};
+
+struct KeyValue {
+  uint key;
+  uint value;
+};
+
+layout (std430, binding = 0) buffer ArraySsbo {
+  KeyValue data[];
+} array;
+
+layout (std430, binding = 1) readonly buffer LargeSegmentSsbo {
+  uvec2 data[]; // offset in array and in the gathered elements of each large segment
+} large_segments;
+
+layout (std430, binding = 2) buffer GatheredSsbo {
+  KeyValue data[];
+} gathered;
+
+layout (std430, binding = 3) buffer SortKeySsbo {
+  uvec2 data[]; // 64-bit keys, large segment above key_bits of key
+} sort_keys;
+
+layout (std430, binding = 4) buffer PositionSsbo {
+  uint data[]; // offset in array of each gathered element
+} positions;
+
+layout (std430, binding = 5) readonly buffer PermutationSsbo {
+  uint data[]; // gathered index of each sorted element
+} permutation;
@@ -0,0 +1,242 @@
+#include <elasticize/utils/trace.h>
+
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <atomic>
+#include <stdexcept>
+
+namespace elastic
+{
+namespace utils
+{
+namespace
+{
+std::string escape(const std::string& s)
+{
+  std::string result;
+  for (auto c : s)
+  {
+    switch (c)
+    {
+    case '"': result += "\\\""; break;
+    case '\\': result += "\\\\"; break;
+    case '\n': result += "\\n"; break;
+    case '\t': result += "\\t"; break;
+    default:
+      if (static_cast<unsigned char>(c) >= 0x20)
+        result += c;
+    }
+  }
+  return result;
+}
+}
+
+class Tracer::Impl
+{
+private:
+  struct Event
+  {
+    std::string name;
+    uint32_t track;
+    TimePoint begin;
+    TimePoint end;
+  };
+
+  struct Thread
+  {
+    uint32_t track = 0;
+    std::vector<std::pair<std::string, TimePoint>> stack;
+  };
+
+public:
+  Impl()
+    : epoch_(Clock::now())
+  {
+  }
+
+  ~Impl() = default;
+
+  void enable(bool enabled) noexcept
+  {
+    enabled_ = enabled;
+  }
+
+  bool enabled() const noexcept
+  {
+    return enabled_;
+  }
+
+  void begin(const std::string& name)
+  {
+    const auto now = Clock::now();
+
+    std::lock_guard<std::mutex> guard(mutex_);
+    thread().stack.emplace_back(name, now);
+  }
+
+  // Without strict, an end() without matching begin() is ignored
+  void end(bool strict)
+  {
+    const auto now = Clock::now();
+
+    std::lock_guard<std::mutex> guard(mutex_);
+    auto& current = thread();
+    if (current.stack.empty())
+    {
+      if (!strict)
+        return;
+      throw std::runtime_error("Tracer::end() called without matching begin()");
+    }
+
+    events_.push_back({ std::move(current.stack.back().first), current.track, current.stack.back().second, now });
+    current.stack.pop_back();
+  }
+
+  void zone(const std::string& name, uint32_t track, TimePoint begin, TimePoint end)
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    events_.push_back({ name, track, begin, end });
+  }
+
+  void clear()
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    events_.clear();
+    epoch_ = Clock::now();
+  }
+
+  void save(const std::string& filepath) const
+  {
+    std::ofstream out(filepath);
+    if (!out)
+      throw std::runtime_error("Failed to open file: " + filepath);
+
+    std::lock_guard<std::mutex> guard(mutex_);
+
+    const auto microseconds = [this](TimePoint timePoint)
+    {
+      return std::chrono::duration<double, std::micro>(timePoint - epoch_).count();
+    };
+
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[" << std::endl;
+
+    // Track names
+    out << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":0,\"args\":{\"name\":\"elasticize\"}}";
+    out << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << gpuTrack << ",\"args\":{\"name\":\"GPU queue\"}}";
+    for (const auto& thread : threads_)
+      out << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << thread.second.track << ",\"args\":{\"name\":\"CPU thread " << thread.second.track << "\"}}";
+
+    out.precision(3);
+    out << std::fixed;
+    for (const auto& event : events_)
+    {
+      out << ",\n{\"name\":\"" << escape(event.name) << "\""
+        << ",\"cat\":\"" << (event.track == gpuTrack ? "gpu" : "cpu") << "\""
+        << ",\"ph\":\"X\",\"pid\":0,\"tid\":" << event.track
+        << ",\"ts\":" << microseconds(event.begin)
+        << ",\"dur\":" << std::chrono::duration<double, std::micro>(event.end - event.begin).count()
+        << "}";
+    }
+
+    out << std::endl << "]}" << std::endl;
+  }
+
+private:
+  // Requires mutex_ held
+  Thread& thread()
+  {
+    const auto id = std::this_thread::get_id();
+    auto it = threads_.find(id);
+    if (it == threads_.end())
+    {
+      it = threads_.emplace(id, Thread{}).first;
+      it->second.track = static_cast<uint32_t>(threads_.size() - 1);
+    }
+    return it->second;
+  }
+
+  std::atomic<bool> enabled_{ false };
+
+  mutable std::mutex mutex_;
+  TimePoint epoch_;
+  std::map<std::thread::id, Thread> threads_;
+  std::vector<Event> events_;
+};
+
+Tracer& Tracer::global()
+{
+  static Tracer tracer;
+  return tracer;
+}
+
+Tracer::Tracer()
+  : impl_(std::make_shared<Impl>())
+{
+}
+
+Tracer::~Tracer() = default;
+
+void Tracer::enable(bool enabled) noexcept
+{
+  impl_->enable(enabled);
+}
+
+bool Tracer::enabled() const noexcept
+{
+  return impl_->enabled();
+}
+
+void Tracer::begin(const std::string& name)
+{
+  impl_->begin(name);
+}
+
+void Tracer::end()
+{
+  impl_->end(true);
+}
+
+void Tracer::endNoThrow() noexcept
+{
+  // A zone that fails to record, e.g. on allocation failure, is dropped
+  try
+  {
+    impl_->end(false);
+  }
+  catch (...)
+  {
+  }
+}
+
+void Tracer::zone(const std::string& name, uint32_t track, TimePoint begin, TimePoint end)
+{
+  impl_->zone(name, track, begin, end);
+}
+
+void Tracer::clear()
+{
+  impl_->clear();
+}
+
+void Tracer::save(const std::string& filepath) const
+{
+  impl_->save(filepath);
+}
+
+TraceScope::TraceScope(const std::string& name)
+  : enabled_(Tracer::global().enabled())
+{
+  if (enabled_)
+    Tracer::global().begin(name);
+}
+
+TraceScope::~TraceScope()
+{
+  if (enabled_)
+    Tracer::global().endNoThrow();
+}
+}
+}